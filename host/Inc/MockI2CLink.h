@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ssd1306/Display.h"
+#include "ssd1306/I2CLink.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// I2CLink backed by a simulated SSD1306. Every transaction takes as long as
+// it would on the real bus, measured on the simulated HAL clock, and data is
+// only latched into the panel RAM when a transfer completes, so drawing into
+// a buffer that is still being sent shows up as tearing in the dumped frames.
+class MockI2CLink : public I2CLink
+{
+public:
+    explicit MockI2CLink(uint32_t clockSpeed = 400000);
+
+    bool Write(uint8_t control, const uint8_t* data, size_t size) override;
+    bool WriteAsync(uint8_t control, const uint8_t* data, size_t size) override;
+
+    // Polling a busy link models a busy-wait: the simulated clock runs to
+    // the end of the transfer in flight.
+    bool IsBusy() const override;
+
+    // Latches every transfer that has finished by the current simulated time.
+    void Poll();
+
+    const std::array<uint8_t, DISPLAY_BUFFER_SIZE>& GetPanelRam() const { return _ram; }
+    bool SavePgm(const std::string& path) const;
+
+    uint64_t GetBytesSent() const { return _bytesSent; }
+    uint32_t GetTransactions() const { return _transactions; }
+    uint64_t GetWaitMicros() const { return _waitMicros; }
+    void ResetStats();
+
+private:
+    void WaitIdle();
+    uint64_t TransferMicros(size_t size) const;
+    void Apply(uint8_t control, const uint8_t* data, size_t size);
+    void ApplyCommands(const uint8_t* data, size_t size);
+
+    uint32_t _clockSpeed;
+
+    bool _busy = false;
+    uint64_t _busyUntil = 0;
+    uint8_t _pendingControl = 0;
+    const uint8_t* _pendingData = nullptr;
+    size_t _pendingSize = 0;
+
+    std::array<uint8_t, DISPLAY_BUFFER_SIZE> _ram{};
+    uint8_t _columnStart = 0;
+    uint8_t _columnEnd = DISPLAY_WIDTH - 1;
+    uint8_t _pageStart = 0;
+    uint8_t _pageEnd = DISPLAY_PAGES - 1;
+    uint8_t _column = 0;
+    uint8_t _page = 0;
+
+    uint64_t _bytesSent = 0;
+    uint32_t _transactions = 0;
+    uint64_t _waitMicros = 0;
+};
@@ -0,0 +1,61 @@
+/**
+  * Host replacement for the parts of the STM32F4 HAL used outside of
+  * stm32/Core. Time is simulated: it only advances through HAL_Delay and
+  * HostHal_AdvanceMicros, so runs are deterministic.
+  */
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+typedef enum
+{
+  GPIO_PIN_RESET = 0,
+  GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct
+{
+  uint16_t IDR;
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef HostHal_GPIOA;
+extern GPIO_TypeDef HostHal_GPIOB;
+extern GPIO_TypeDef HostHal_GPIOC;
+
+#define GPIOA (&HostHal_GPIOA)
+#define GPIOB (&HostHal_GPIOB)
+#define GPIOC (&HostHal_GPIOC)
+
+#define GPIO_PIN_0  ((uint16_t)0x0001)
+#define GPIO_PIN_1  ((uint16_t)0x0002)
+#define GPIO_PIN_2  ((uint16_t)0x0004)
+#define GPIO_PIN_3  ((uint16_t)0x0008)
+#define GPIO_PIN_4  ((uint16_t)0x0010)
+#define GPIO_PIN_5  ((uint16_t)0x0020)
+#define GPIO_PIN_6  ((uint16_t)0x0040)
+#define GPIO_PIN_7  ((uint16_t)0x0080)
+#define GPIO_PIN_8  ((uint16_t)0x0100)
+#define GPIO_PIN_9  ((uint16_t)0x0200)
+
+extern uint32_t SystemCoreClock;
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+/* Host only: drive the simulated clock and input pins */
+uint64_t HostHal_GetMicros(void);
+void HostHal_AdvanceMicros(uint64_t micros);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32F4xx_HAL_H */
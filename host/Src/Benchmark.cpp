@@ -0,0 +1,185 @@
+extern "C"
+{
+#include "stm32f4xx_hal.h"
+}
+
+#include "ssd1306/Display.h"
+#include "Game/Game.h"
+#include "MockI2CLink.h"
+#include "Profiler/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Drives Game with a scripted input trace and a fixed dt and reports the
+// cost of each stage of the main loop.
+// Usage: ArkanoidBench [frames] [trace file or -] [incremental|compose]
+//
+// A trace file has one "<frames> <L|R|->" entry per line and is replayed in
+// a loop, e.g. "60 L" holds the left button for one second.
+
+class GameBenchmark
+{
+public:
+    static void UpdateCollisions(Game& game) { game.UpdateCollisions(); }
+};
+
+namespace
+{
+    struct TraceEntry
+    {
+        int frames;
+        bool left;
+        bool right;
+    };
+
+    struct Stage
+    {
+        const char* name;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+
+        void Add(uint64_t ns)
+        {
+            totalNs += ns;
+            maxNs = std::max(maxNs, ns);
+        }
+    };
+
+    std::vector<TraceEntry> DefaultTrace()
+    {
+        return {{45, true, false}, {20, false, false}, {90, false, true}, {20, false, false}, {45, true, false}};
+    }
+
+    bool LoadTrace(const char* path, std::vector<TraceEntry>& trace)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            return false;
+        }
+
+        int frames = 0;
+        char button = '-';
+        while (file >> frames >> button)
+        {
+            trace.push_back({frames, button == 'L', button == 'R'});
+        }
+
+        return !trace.empty();
+    }
+
+    template<typename Func>
+    uint64_t TimeNs(Func&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 100000;
+
+    std::vector<TraceEntry> trace;
+    if (argc > 2 && std::string(argv[2]) != "-")
+    {
+        if (!LoadTrace(argv[2], trace))
+        {
+            std::fprintf(stderr, "Failed to read trace %s\n", argv[2]);
+            return 1;
+        }
+    }
+    else
+    {
+        trace = DefaultTrace();
+    }
+
+    MockI2CLink link;
+    Display display;
+    display.Init(&link);
+    display.SetFrameDiff(true);
+    link.ResetStats();
+
+    const bool compose = argc > 3 && std::string(argv[3]) == "compose";
+
+    Game game;
+    game.Init();
+    game.SetRenderMode(compose ? RenderMode::PageCompose : RenderMode::Incremental);
+
+    constexpr float dt = 1.f / 60.f;
+    constexpr uint64_t frameMicros = 1000000 / 60;
+
+    Stage update{"Update"};
+    Stage collisions{"UpdateCollisions"};
+    Stage draw{"Draw"};
+
+    size_t traceIndex = 0;
+    int traceFrames = 0;
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        const TraceEntry& input = trace[traceIndex];
+        if (++traceFrames >= input.frames)
+        {
+            traceFrames = 0;
+            traceIndex = (traceIndex + 1) % trace.size();
+        }
+
+        const uint64_t frameStart = HostHal_GetMicros();
+
+        // Same state as the call made inside Update, timed on a copy.
+        Game probe = game;
+        collisions.Add(TimeNs([&] { GameBenchmark::UpdateCollisions(probe); }));
+
+        update.Add(TimeNs([&] {
+            game.Update(dt);
+            if (input.left)
+            {
+                game.OnLeftPressed();
+            }
+            if (input.right)
+            {
+                game.OnRightPressed();
+            }
+        }));
+
+        draw.Add(TimeNs([&] { game.Draw(display); }));
+
+        const uint64_t elapsed = HostHal_GetMicros() - frameStart;
+        if (elapsed < frameMicros)
+        {
+            HostHal_AdvanceMicros(frameMicros - elapsed);
+        }
+    }
+
+    std::printf("frames: %d, dt %.3f ms, %s renderer\n\n", frames, dt * 1000.f,
+                compose ? "page compose" : "incremental");
+    std::printf("%-18s %10s %10s\n", "stage", "avg ns", "max ns");
+    for (const Stage* stage : {&update, &collisions, &draw})
+    {
+        std::printf("%-18s %10.1f %10llu\n", stage->name,
+                    static_cast<double>(stage->totalNs) / frames,
+                    static_cast<unsigned long long>(stage->maxNs));
+    }
+
+    std::printf("\ni2c bytes:     %llu (%.1f per frame)\n",
+                static_cast<unsigned long long>(link.GetBytesSent()),
+                static_cast<double>(link.GetBytesSent()) / frames);
+    std::printf("transactions:  %u (%.1f per frame)\n", link.GetTransactions(),
+                static_cast<double>(link.GetTransactions()) / frames);
+    std::printf("wait on link:  %llu us\n", static_cast<unsigned long long>(link.GetWaitMicros()));
+
+#ifdef ARKANOID_PROFILE
+    std::printf("\nprofiling zones (last %u samples):\n", Profiler::RING_SIZE);
+    Profiler::Report();
+#endif
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include "MockI2CLink.h"
+
+#include "stm32f4xx_hal.h"
+
+#include <fstream>
+
+namespace
+{
+    // START, address and control byte, payload, STOP; 9 clocks per byte.
+    constexpr uint32_t BITS_PER_BYTE = 9;
+    constexpr uint32_t FRAMING_BITS = 2 * BITS_PER_BYTE + 2;
+
+    size_t CommandArguments(uint8_t command)
+    {
+        switch (command)
+        {
+            case 0x21:
+            case 0x22:
+                return 2;
+            case 0x20:
+            case 0x81:
+            case 0x8D:
+            case 0xA8:
+            case 0xD3:
+            case 0xD5:
+            case 0xD9:
+            case 0xDA:
+            case 0xDB:
+                return 1;
+            default:
+                return 0;
+        }
+    }
+}
+
+MockI2CLink::MockI2CLink(uint32_t clockSpeed)
+{
+    _clockSpeed = clockSpeed;
+}
+
+bool MockI2CLink::Write(uint8_t control, const uint8_t* data, size_t size)
+{
+    WaitIdle();
+
+    HostHal_AdvanceMicros(TransferMicros(size));
+    Apply(control, data, size);
+    return true;
+}
+
+bool MockI2CLink::WriteAsync(uint8_t control, const uint8_t* data, size_t size)
+{
+    WaitIdle();
+
+    _busy = true;
+    _busyUntil = HostHal_GetMicros() + TransferMicros(size);
+    _pendingControl = control;
+    _pendingData = data;
+    _pendingSize = size;
+    return true;
+}
+
+bool MockI2CLink::IsBusy() const
+{
+    MockI2CLink* self = const_cast<MockI2CLink*>(this);
+    self->Poll();
+    if (!_busy)
+    {
+        return false;
+    }
+
+    const uint64_t now = HostHal_GetMicros();
+    self->_waitMicros += _busyUntil - now;
+    HostHal_AdvanceMicros(_busyUntil - now);
+    self->Poll();
+    return _busy;
+}
+
+void MockI2CLink::Poll()
+{
+    if (!_busy || HostHal_GetMicros() < _busyUntil)
+    {
+        return;
+    }
+
+    _busy = false;
+    Apply(_pendingControl, _pendingData, _pendingSize);
+    NotifyComplete(true);
+}
+
+void MockI2CLink::WaitIdle()
+{
+    while (IsBusy())
+    {
+    }
+}
+
+uint64_t MockI2CLink::TransferMicros(size_t size) const
+{
+    const uint64_t bits = FRAMING_BITS + BITS_PER_BYTE * static_cast<uint64_t>(size);
+    return (bits * 1000000u + _clockSpeed - 1) / _clockSpeed;
+}
+
+void MockI2CLink::Apply(uint8_t control, const uint8_t* data, size_t size)
+{
+    _bytesSent += size + 2;
+    _transactions++;
+
+    if (control == SSD1306_CONTROL_COMMAND)
+    {
+        ApplyCommands(data, size);
+        return;
+    }
+
+    // Horizontal addressing mode: the pointer wraps inside the window.
+    for (size_t i = 0; i < size; ++i)
+    {
+        _ram[_page * DISPLAY_WIDTH + _column] = data[i];
+
+        if (++_column > _columnEnd)
+        {
+            _column = _columnStart;
+            if (++_page > _pageEnd)
+            {
+                _page = _pageStart;
+            }
+        }
+    }
+}
+
+void MockI2CLink::ApplyCommands(const uint8_t* data, size_t size)
+{
+    size_t i = 0;
+    while (i < size)
+    {
+        const uint8_t command = data[i];
+        const size_t arguments = CommandArguments(command);
+        if (i + arguments >= size && arguments > 0)
+        {
+            break;
+        }
+
+        if (command == 0x21)
+        {
+            _columnStart = data[i + 1] % DISPLAY_WIDTH;
+            _columnEnd = data[i + 2] % DISPLAY_WIDTH;
+            _column = _columnStart;
+        }
+        else if (command == 0x22)
+        {
+            _pageStart = data[i + 1] % DISPLAY_PAGES;
+            _pageEnd = data[i + 2] % DISPLAY_PAGES;
+            _page = _pageStart;
+        }
+
+        i += 1 + arguments;
+    }
+}
+
+bool MockI2CLink::SavePgm(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    file << "P5\n" << int(DISPLAY_WIDTH) << " " << int(DISPLAY_HEIGHT) << "\n255\n";
+
+    // Page 0 is at the bottom of the panel (COM scan from COM0).
+    for (int row = DISPLAY_HEIGHT - 1; row >= 0; --row)
+    {
+        for (int x = 0; x < DISPLAY_WIDTH; ++x)
+        {
+            const bool lit = _ram[(row / 8) * DISPLAY_WIDTH + x] & (1u << (row % 8));
+            file.put(lit ? static_cast<char>(255) : 0);
+        }
+    }
+
+    return static_cast<bool>(file);
+}
+
+void MockI2CLink::ResetStats()
+{
+    _bytesSent = 0;
+    _transactions = 0;
+    _waitMicros = 0;
+}
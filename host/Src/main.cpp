@@ -0,0 +1,98 @@
+extern "C"
+{
+#include "stm32f4xx_hal.h"
+}
+
+#include "ssd1306/Display.h"
+#include "Game/Game.h"
+#include "MockI2CLink.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+// Runs the game loop from src/main.cpp against the simulated panel.
+// Usage: ArkanoidHost [frames] [output dir for PGM frames] [dump every N frames] [incremental|compose]
+int main(int argc, char** argv)
+{
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 600;
+    const std::string outputDir = argc > 2 ? argv[2] : "";
+    const int dumpEvery = argc > 3 ? std::max(1, std::atoi(argv[3])) : 1;
+    const bool compose = argc > 4 && std::string(argv[4]) == "compose";
+
+    if (!outputDir.empty())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(outputDir, error);
+        if (error)
+        {
+            std::fprintf(stderr, "Failed to create %s: %s\n", outputDir.c_str(), error.message().c_str());
+            return 1;
+        }
+    }
+
+    MockI2CLink link;
+    Display display;
+    display.Init(&link);
+    display.SetFrameDiff(true);
+    link.ResetStats();
+
+    Game game;
+    game.Init();
+    game.SetRenderMode(compose ? RenderMode::PageCompose : RenderMode::Incremental);
+
+    constexpr float dt = 1.f / 60.f;
+    constexpr uint64_t frameMicros = 1000000 / 60;
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        const uint64_t frameStart = HostHal_GetMicros();
+
+        // Sweep the platform across the field, one second each way.
+        const bool left = (frame / 60) % 2 == 0;
+        HAL_GPIO_WritePin(GPIOC, GPIO_PIN_2, left ? GPIO_PIN_SET : GPIO_PIN_RESET);
+        HAL_GPIO_WritePin(GPIOC, GPIO_PIN_3, left ? GPIO_PIN_RESET : GPIO_PIN_SET);
+
+        game.Update(dt);
+        if (HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_2))
+        {
+            game.OnLeftPressed();
+        }
+        if (HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_3))
+        {
+            game.OnRightPressed();
+        }
+
+        game.Draw(display);
+
+        const uint64_t elapsed = HostHal_GetMicros() - frameStart;
+        if (elapsed < frameMicros)
+        {
+            HostHal_AdvanceMicros(frameMicros - elapsed);
+        }
+
+        if (!outputDir.empty() && frame % dumpEvery == 0)
+        {
+            link.Poll();
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "/frame%05d.pgm", frame);
+            if (!link.SavePgm(outputDir + name))
+            {
+                std::fprintf(stderr, "Failed to write %s%s\n", outputDir.c_str(), name);
+                return 1;
+            }
+        }
+    }
+
+    std::printf("frames:        %d\n", frames);
+    std::printf("i2c bytes:     %llu (%.1f per frame)\n",
+                static_cast<unsigned long long>(link.GetBytesSent()),
+                static_cast<double>(link.GetBytesSent()) / frames);
+    std::printf("transactions:  %u\n", link.GetTransactions());
+    std::printf("wait on link:  %llu us\n", static_cast<unsigned long long>(link.GetWaitMicros()));
+    return 0;
+}
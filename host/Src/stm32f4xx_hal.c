@@ -0,0 +1,46 @@
+#include "stm32f4xx_hal.h"
+
+GPIO_TypeDef HostHal_GPIOA;
+GPIO_TypeDef HostHal_GPIOB;
+GPIO_TypeDef HostHal_GPIOC;
+
+uint32_t SystemCoreClock = 84000000;
+
+static uint64_t s_micros = 0;
+
+uint32_t HAL_GetTick(void)
+{
+  return (uint32_t)(s_micros / 1000u);
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+  s_micros += (uint64_t)Delay * 1000u;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+  return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  if (PinState == GPIO_PIN_SET)
+  {
+    GPIOx->IDR |= GPIO_Pin;
+  }
+  else
+  {
+    GPIOx->IDR &= (uint16_t)~GPIO_Pin;
+  }
+}
+
+uint64_t HostHal_GetMicros(void)
+{
+  return s_micros;
+}
+
+void HostHal_AdvanceMicros(uint64_t micros)
+{
+  s_micros += micros;
+}
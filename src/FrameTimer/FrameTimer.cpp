@@ -0,0 +1,82 @@
+#include "FrameTimer.h"
+
+extern "C"
+{
+#include "stm32f4xx_hal.h"
+}
+
+void (*FrameTimer::_frameCallback)() = nullptr;
+volatile uint32_t FrameTimer::_frames = 0;
+uint32_t FrameTimer::_period = 1;
+
+void FrameTimer::Start(uint32_t framesPerSecond)
+{
+    // APB1 timers run at twice PCLK1 whenever APB1 is divided.
+    uint32_t timerClock = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+    {
+        timerClock *= 2;
+    }
+
+    _period = TICKS_PER_SECOND / framesPerSecond;
+    _frames = 0;
+
+    __HAL_RCC_TIM6_CLK_ENABLE();
+    TIM6->CR1 = TIM_CR1_ARPE | TIM_CR1_URS;
+    TIM6->PSC = timerClock / TICKS_PER_SECOND - 1;
+    TIM6->ARR = _period - 1;
+    TIM6->CNT = 0;
+    TIM6->EGR = TIM_EGR_UG;
+    TIM6->SR = 0;
+    TIM6->DIER = TIM_DIER_UIE;
+
+    HAL_NVIC_SetPriority(TIM6_DAC_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(TIM6_DAC_IRQn);
+
+    TIM6->CR1 |= TIM_CR1_CEN;
+}
+
+uint32_t FrameTimer::Now()
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // An update that is pending but not yet handled belongs to this count.
+    uint32_t frames = _frames;
+    const uint32_t count = TIM6->CNT;
+    if ((TIM6->SR & TIM_SR_UIF) && count < _period / 2)
+    {
+        ++frames;
+    }
+
+    __set_PRIMASK(primask);
+    return frames * _period + count;
+}
+
+void FrameTimer::WaitForFrame()
+{
+    const uint32_t frame = _frames;
+    while (_frames == frame)
+    {
+        __WFI();
+    }
+}
+
+void FrameTimer::OnUpdate()
+{
+    if (TIM6->SR & TIM_SR_UIF)
+    {
+        TIM6->SR = ~TIM_SR_UIF;
+        _frames = _frames + 1;
+        if (_frameCallback != nullptr)
+        {
+            _frameCallback();
+        }
+    }
+}
+
+// Called by TIM6_DAC_IRQHandler in stm32f4xx_it.c.
+extern "C" void FrameTimer_IRQHandler()
+{
+    FrameTimer::OnUpdate();
+}
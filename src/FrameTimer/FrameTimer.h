@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+// Frame scheduler on TIM6. The timer counts microseconds and raises an
+// update interrupt once per frame period; WaitForFrame sleeps the core in
+// WFI until then. Now() doubles as the game clock, which keeps running
+// while the core sleeps (unlike the DWT cycle counter).
+class FrameTimer
+{
+public:
+    static constexpr uint32_t TICKS_PER_SECOND = 1000000;
+
+    static void Start(uint32_t framesPerSecond);
+    static uint32_t Now();
+    static void WaitForFrame();
+
+    // Called from the timer interrupt once per frame.
+    static void SetFrameCallback(void (*callback)()) { _frameCallback = callback; }
+
+    static void OnUpdate();
+
+private:
+    static void (*_frameCallback)();
+    static volatile uint32_t _frames;
+    static uint32_t _period;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Scalar.h"
+
+#include <array>
+#include <cstddef>
+
+// Number of distinct directions the ball can leave the platform in, spread
+// evenly over the platform width. Higher values give finer control.
+constexpr size_t BOUNCE_DIRECTIONS = 33;
+
+namespace BounceTableDetail
+{
+    // Taylor series, accurate to float precision for |x| < PI.
+    constexpr double Sin(double x)
+    {
+        double term = x;
+        double sum = x;
+        for (int n = 1; n < 12; ++n)
+        {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    constexpr double Cos(double x)
+    {
+        double term = 1.0;
+        double sum = 1.0;
+        for (int n = 1; n < 12; ++n)
+        {
+            term *= -x * x / ((2 * n - 1) * (2 * n));
+            sum += term;
+        }
+        return sum;
+    }
+}
+
+// Unit direction vectors for angles from minAngle to maxAngle (radians),
+// built at compile time.
+template<size_t N>
+struct BounceTable
+{
+    static_assert(N >= 2, "A bounce table needs at least both end directions");
+
+    std::array<Scalar, N> x{};
+    std::array<Scalar, N> y{};
+
+    constexpr BounceTable(double minAngle, double maxAngle)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            const double angle = minAngle + (maxAngle - minAngle) * i / (N - 1);
+            x[i] = static_cast<float>(BounceTableDetail::Cos(angle));
+            y[i] = static_cast<float>(BounceTableDetail::Sin(angle));
+        }
+    }
+
+    // Index of the direction for t in [0, 1].
+    static int Index(Scalar t)
+    {
+        const int index = RoundToInt(t * static_cast<int>(N - 1));
+        return index < 0 ? 0 : index >= static_cast<int>(N) ? static_cast<int>(N) - 1 : index;
+    }
+};
@@ -0,0 +1,82 @@
+#include "BrickField.h"
+
+#include "Profiler/Profiler.h"
+#include "Sprites.h"
+
+namespace
+{
+    const Sprite& GetBrickSprite(uint8_t level)
+    {
+        switch (level)
+        {
+            default:
+            case 1:
+                return Sprites::Brick01;
+            case 2:
+                return Sprites::Brick02;
+            case 3:
+                return Sprites::Brick03;
+        }
+    }
+}
+
+void BrickField::Load(const LevelLayout& layout)
+{
+    _levels = layout.rows;
+    for (uint8_t row = 0; row < ROWS; ++row)
+    {
+        // Bit 2c is set when cell c holds a brick; squeeze those bits into
+        // the alive mask.
+        uint32_t alive = (_levels[row] | (_levels[row] >> 1)) & 0x5555;
+        alive = (alive | (alive >> 1)) & 0x3333;
+        alive = (alive | (alive >> 2)) & 0x0F0F;
+        alive = (alive | (alive >> 4)) & 0x00FF;
+        _alive[row] = static_cast<uint8_t>(alive);
+    }
+    _dirty.fill(0xFF >> (8 - COLUMNS));
+}
+
+void BrickField::Draw(Display& display)
+{
+    PROFILE_ZONE(DrawObject);
+
+    for (uint8_t row = 0; row < ROWS; ++row)
+    {
+        for (uint32_t bits = _dirty[row]; bits != 0; bits &= bits - 1)
+        {
+            const uint8_t column = LowestBit(bits);
+            const uint8_t x = column * BRICK_CELL_WIDTH;
+            const uint8_t y = row * BRICK_CELL_HEIGHT;
+
+            display.DrawRect(x, y, BRICK_CELL_WIDTH, BRICK_CELL_HEIGHT, false);
+            if (_alive[row] & (1u << column))
+            {
+                display.DrawSprite(x, y, GetBrickSprite(GetLevel(column, row)));
+            }
+        }
+        _dirty[row] = 0;
+    }
+}
+
+uint8_t BrickField::GetRedrawPages() const
+{
+    uint8_t pages = 0;
+    for (uint8_t row = 0; row < ROWS; ++row)
+    {
+        if (_dirty[row] != 0)
+        {
+            pages |= 1u << row;
+        }
+    }
+    return pages;
+}
+
+void BrickField::DrawPage(PageLine& line) const
+{
+    const uint8_t row = line.GetPage();
+    for (uint32_t bits = _alive[row]; bits != 0; bits &= bits - 1)
+    {
+        const uint8_t column = LowestBit(bits);
+        line.DrawSprite(column * BRICK_CELL_WIDTH, row * BRICK_CELL_HEIGHT, GetBrickSprite(GetLevel(column, row)));
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Broadphase.h"
+#include "ssd1306/Display.h"
+#include "ssd1306/PageLine.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+constexpr uint8_t BRICK_CELL_WIDTH = 16;
+constexpr uint8_t BRICK_CELL_HEIGHT = 8;
+constexpr uint8_t BRICK_WIDTH = BRICK_CELL_WIDTH - 1;
+constexpr uint8_t BRICK_HEIGHT = BRICK_CELL_HEIGHT - 1;
+
+struct LevelLayout;
+
+// The bricks of a level on a fixed grid of cells. Every row keeps the
+// levels of its cells packed as 2-bit values (0 means no brick), a mask of
+// the cells holding a brick and a mask of the cells that changed since they
+// were last drawn. Queries and redraws walk the set bits of those masks.
+class BrickField
+{
+public:
+    static constexpr uint8_t COLUMNS = DISPLAY_WIDTH / BRICK_CELL_WIDTH;
+    static constexpr uint8_t ROWS = DISPLAY_HEIGHT / BRICK_CELL_HEIGHT;
+    static constexpr uint8_t MAX_LEVEL = 3;
+
+    static_assert(COLUMNS <= 8, "A row mask is one byte");
+    static_assert(BRICK_CELL_HEIGHT == 8, "Every row of cells is one display page");
+
+    BrickField() { Clear(); }
+
+    // Removes every brick and marks every cell for redraw.
+    void Clear()
+    {
+        _levels.fill(0);
+        _alive.fill(0);
+        _dirty.fill(0xFF >> (8 - COLUMNS));
+    }
+
+    // Replaces the whole field; a few word operations per row.
+    void Load(const LevelLayout& layout);
+
+    void Set(uint8_t column, uint8_t row, uint8_t level)
+    {
+        const uint8_t shift = column * 2;
+        const uint8_t bit = 1u << column;
+
+        _levels[row] = (_levels[row] & ~(3u << shift)) | ((level & 3u) << shift);
+        _alive[row] = level != 0 ? (_alive[row] | bit) : (_alive[row] & ~bit);
+        _dirty[row] |= bit;
+    }
+
+    uint8_t GetLevel(uint8_t column, uint8_t row) const
+    {
+        return (_levels[row] >> (column * 2)) & 3u;
+    }
+
+    bool IsEmpty() const
+    {
+        return std::all_of(_alive.begin(), _alive.end(), [](uint8_t mask) { return mask == 0; });
+    }
+
+    // Takes one level off the brick; it disappears at level 0.
+    void Hit(uint8_t column, uint8_t row)
+    {
+        const uint8_t level = GetLevel(column, row);
+        if (level != 0)
+        {
+            Set(column, row, level - 1);
+        }
+    }
+
+    void MarkDirty(uint8_t column, uint8_t row)
+    {
+        _dirty[row] |= 1u << column;
+    }
+
+    // Pixel box around every brick, including the half pixel their collision
+    // rects reach outside the cells. False when no brick is left.
+    bool GetBounds(ByteBox& bounds) const
+    {
+        uint32_t columns = 0;
+        uint32_t rows = 0;
+        for (uint8_t row = 0; row < ROWS; ++row)
+        {
+            columns |= _alive[row];
+            rows |= uint32_t(_alive[row] != 0) << row;
+        }
+        if (rows == 0)
+        {
+            return false;
+        }
+
+        bounds.minX = std::max(0, LowestBit(columns) * BRICK_CELL_WIDTH - 1);
+        bounds.minY = std::max(0, LowestBit(rows) * BRICK_CELL_HEIGHT - 1);
+        bounds.maxX = (HighestBit(columns) + 1) * BRICK_CELL_WIDTH;
+        bounds.maxY = (HighestBit(rows) + 1) * BRICK_CELL_HEIGHT;
+        return true;
+    }
+
+    // Collision rect of a cell; it reaches half a pixel outside the cell.
+    static Rect GetCellRect(uint8_t column, uint8_t row)
+    {
+        return {Scalar(column * BRICK_CELL_WIDTH) - 0.5f, Scalar(row * BRICK_CELL_HEIGHT) - 0.5f,
+                Scalar(BRICK_CELL_WIDTH), Scalar(BRICK_CELL_HEIGHT)};
+    }
+
+    // Calls func(column, row) for every brick whose cell overlaps the area,
+    // row by row from the bottom and left to right.
+    template<typename Func>
+    void ForEachInArea(const Rect& area, Func func) const
+    {
+        const int columnMin = std::max(0, Floor(area.x / BRICK_CELL_WIDTH));
+        const int columnMax = std::min(COLUMNS - 1, Floor((area.x + area.w) / BRICK_CELL_WIDTH));
+        const int rowMin = std::max(0, Floor(area.y / BRICK_CELL_HEIGHT));
+        const int rowMax = std::min(ROWS - 1, Floor((area.y + area.h) / BRICK_CELL_HEIGHT));
+        if (columnMin > columnMax)
+        {
+            return;
+        }
+
+        const uint32_t columns = (0xFFu >> (7 - columnMax)) & (0xFFu << columnMin);
+        for (int row = rowMin; row <= rowMax; ++row)
+        {
+            for (uint32_t bits = _alive[row] & columns; bits != 0; bits &= bits - 1)
+            {
+                func(static_cast<uint8_t>(LowestBit(bits)), static_cast<uint8_t>(row));
+            }
+        }
+    }
+
+    // Erases and redraws the changed cells.
+    void Draw(Display& display);
+    // One bit per page holding a changed cell.
+    uint8_t GetRedrawPages() const;
+    void DrawPage(PageLine& line) const;
+    void MarkDrawn() { _dirty.fill(0); }
+
+private:
+    std::array<uint16_t, ROWS> _levels;
+    std::array<uint8_t, ROWS> _alive;
+    std::array<uint8_t, ROWS> _dirty;
+};
+
+// Brick levels of every cell, packed as in BrickField: one word per row of
+// cells from the bottom, 2 bits per cell from the left.
+struct LevelLayout
+{
+    std::array<uint16_t, BrickField::ROWS> rows;
+};
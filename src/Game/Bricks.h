@@ -1,14 +0,0 @@
-#include <array>
-#include <cstdint>
-
-constexpr std::array<uint8_t, 16> Brick01 = {
-    0x7C, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0x7C, 0x00
-};
-
-constexpr std::array<uint8_t, 16> Brick02 = {
-    0x7C, 0xC6, 0xBA, 0xBA, 0xBA, 0xBA, 0xBA, 0xBA, 0xBA, 0xBA, 0xBA, 0xBA, 0xBA, 0xC6, 0x7C, 0x00
-};
-
-constexpr std::array<uint8_t, 16> Brick03 = {
-    0x7C, 0xC6, 0xBA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xBA, 0xC6, 0x7C, 0x00
-};
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(STM32F446xx) && defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP == 1
+extern "C"
+{
+#include "stm32f4xx.h"
+}
+#define ARKANOID_SIMD_BROADPHASE
+#endif
+
+// Box in whole pixels with inclusive bounds.
+struct ByteBox
+{
+    uint8_t minX;
+    uint8_t minY;
+    uint8_t maxX;
+    uint8_t maxY;
+};
+
+// Four boxes with each bound packed into one word, box i in byte i.
+struct ByteBoxes4
+{
+    // Unused lanes hold a box that overlaps nothing.
+    uint32_t minX = 0xFFFFFFFF;
+    uint32_t minY = 0xFFFFFFFF;
+    uint32_t maxX = 0;
+    uint32_t maxY = 0;
+
+    void Set(uint8_t lane, const ByteBox& box)
+    {
+        const uint8_t shift = lane * 8;
+        const uint32_t mask = ~(0xFFu << shift);
+        minX = (minX & mask) | (uint32_t(box.minX) << shift);
+        minY = (minY & mask) | (uint32_t(box.minY) << shift);
+        maxX = (maxX & mask) | (uint32_t(box.maxX) << shift);
+        maxY = (maxY & mask) | (uint32_t(box.maxY) << shift);
+    }
+};
+
+namespace Broadphase
+{
+    // 0xFF in every byte where a >= b, 0x00 elsewhere.
+    inline uint32_t GreaterEqual4(uint32_t a, uint32_t b)
+    {
+#ifdef ARKANOID_SIMD_BROADPHASE
+        // USUB8 sets one GE flag per byte that did not borrow; SEL turns the
+        // flags back into byte masks.
+        __USUB8(a, b);
+        return __SEL(0xFFFFFFFF, 0);
+#else
+        uint32_t result = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            if (((a >> shift) & 0xFF) >= ((b >> shift) & 0xFF))
+            {
+                result |= 0xFFu << shift;
+            }
+        }
+        return result;
+#endif
+    }
+
+    // Bit i is set when box i of boxes overlaps box. Bounds are compared
+    // four at a time, so the whole test is four byte-wise compares.
+    inline uint8_t Overlaps4(const ByteBoxes4& boxes, const ByteBox& box)
+    {
+        constexpr uint32_t SPLAT = 0x01010101;
+
+        const uint32_t overlap = GreaterEqual4(box.maxX * SPLAT, boxes.minX)
+                               & GreaterEqual4(boxes.maxX, box.minX * SPLAT)
+                               & GreaterEqual4(box.maxY * SPLAT, boxes.minY)
+                               & GreaterEqual4(boxes.maxY, box.minY * SPLAT);
+
+        // Gather the low bit of every byte into bits 0-3.
+        uint32_t bits = overlap & SPLAT;
+        bits |= bits >> 7;
+        bits |= bits >> 14;
+        return static_cast<uint8_t>(bits & 0xF);
+    }
+}
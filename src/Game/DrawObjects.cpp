@@ -1,45 +1,17 @@
 #include "DrawObjects.h"
 
-DrawObject::DrawObject(uint8_t x, uint8_t y)
-{
-    _x = x;
-    _y = y;
-    _prevX = x;
-    _prevY = y;
-}
+#include <algorithm>
 
-void DrawObject::Draw(Display& display)
+uint8_t RowPages(int y, int height)
 {
-    if (_x != _prevX || _y != _prevY || IsDirty())
+    static_assert(DISPLAY_PAGES == 8, "Page masks are one byte");
+
+    const int first = std::max(0, y) / 8;
+    const int last = std::min(DISPLAY_HEIGHT - 1, y + height - 1) / 8;
+    if (height <= 0 || first > last)
     {
-        OnDraw(display, _prevX, _prevY, false);
-        OnDraw(display, _x, _y, true);
-        _prevX = _x;
-        _prevY = _y;
-        _dirty = false;
+        return 0;
     }
-}
 
-DrawRectObject::DrawRectObject(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
-    : DrawObject(x, y)
-{
-    _width = width;
-    _height = height;
+    return static_cast<uint8_t>((0xFFu >> (7 - last)) & (0xFFu << first));
 }
-
-void DrawRectObject::OnDraw(Display& display, uint8_t x, uint8_t y, bool color) const
-{
-    display.DrawRect(x, y, _width, _height, color);
-}
-
-DrawCircleObject::DrawCircleObject(uint8_t x, uint8_t y, uint8_t radius, bool fill)
-    : DrawObject(x, y)
-{
-    _radius = radius;
-    _fill = fill;
-}
-
-void DrawCircleObject::OnDraw(Display& display, uint8_t x, uint8_t y, bool color) const
-{
-    display.DrawCircle(x, y, _radius, color, _fill);
-}
\ No newline at end of file
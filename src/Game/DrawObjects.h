@@ -1,14 +1,70 @@
 #pragma once
 
 #include "ssd1306/Display.h"
+#include "ssd1306/PageLine.h"
+#include "Profiler/Profiler.h"
 #include "Utils.h"
 
+// Bit mask of the pages covered by rows [y, y + height).
+uint8_t RowPages(int y, int height);
+
+// Drawable objects use static polymorphism: Derived provides OnDraw and
+// OnDrawPage, and may hide GetDrawOffsetY/GetDrawHeight, so every call is
+// resolved at compile time and objects carry no vtable pointer.
+template<typename Derived>
 class DrawObject
 {
     public:
-        DrawObject(uint8_t x, uint8_t y);
-        void Draw(Display& display);
-        virtual void OnDraw(Display& display, uint8_t x, uint8_t y, bool color) const = 0;
+        DrawObject(uint8_t x, uint8_t y)
+            : _x(x), _y(y), _prevX(x), _prevY(y)
+        {
+        }
+
+        void Draw(Display& display)
+        {
+            PROFILE_ZONE(DrawObject);
+
+            if (NeedsRedraw())
+            {
+                Self().OnDraw(display, _prevX, _prevY, false);
+                Self().OnDraw(display, _x, _y, true);
+                MarkDrawn();
+            }
+        }
+
+        // Page compositor: instead of erasing and redrawing, every page the
+        // object covered or covers is recomposed. GetRedrawPages is that set
+        // as a bit mask (0 when nothing changed since MarkDrawn).
+        uint8_t GetRedrawPages() const
+        {
+            if (!NeedsRedraw())
+            {
+                return 0;
+            }
+
+            return RowPages(_prevY + Self().GetDrawOffsetY(), Self().GetDrawHeight())
+                 | RowPages(_y + Self().GetDrawOffsetY(), Self().GetDrawHeight());
+        }
+
+        void DrawPage(PageLine& line) const
+        {
+            if (line.IntersectsRows(_y + Self().GetDrawOffsetY(), Self().GetDrawHeight()))
+            {
+                Self().OnDrawPage(line, _x, _y);
+            }
+        }
+
+        void MarkDrawn()
+        {
+            _prevX = _x;
+            _prevY = _y;
+            _dirty = false;
+        }
+
+        // Rows [y + offset, y + offset + height) the object covers when drawn at y.
+        int GetDrawOffsetY() const { return 0; }
+
+        bool NeedsRedraw() const { return _x != _prevX || _y != _prevY || _dirty; }
 
         uint8_t GetX() const { return _x; }
         uint8_t GetY() const { return _y; }
@@ -17,6 +73,8 @@ class DrawObject
         void SetDirty(bool dirty) { _dirty = dirty; }
 
     protected:
+        const Derived& Self() const { return static_cast<const Derived&>(*this); }
+
         uint8_t _x;
         uint8_t _y;
         uint8_t _prevX;
@@ -24,35 +82,37 @@ class DrawObject
         bool _dirty = true;
 };
 
-class DrawRectObject : public DrawObject
+template<typename Derived>
+class DrawRectObject : public DrawObject<Derived>
 {
     public:
-        DrawRectObject(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+        DrawRectObject(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+            : DrawObject<Derived>(x, y), _width(width), _height(height)
+        {
+        }
 
-        void OnDraw(Display& display, uint8_t x, uint8_t y, bool color) const override;
+        void OnDraw(Display& display, uint8_t x, uint8_t y, bool color) const
+        {
+            display.DrawRect(x, y, _width, _height, color);
+        }
+
+        void OnDrawPage(PageLine& line, uint8_t x, uint8_t y) const
+        {
+            line.DrawRect(x, y, _width, _height, true);
+        }
+
+        int GetDrawHeight() const { return _height; }
 
         uint8_t GetWidth() const { return _width; }
         uint8_t GetHeight() const { return _height; }
 
-        virtual Rect GetRect() const { return {_x, _y, _width, _height}; }
+        Rect GetRect() const
+        {
+            return {static_cast<Scalar>(this->_x), static_cast<Scalar>(this->_y),
+                    static_cast<Scalar>(_width), static_cast<Scalar>(_height)};
+        }
 
     protected:
         uint8_t _width;
         uint8_t _height;
 };
-
-class DrawCircleObject : public DrawObject
-{
-    public:
-        DrawCircleObject(uint8_t x, uint8_t y, uint8_t radius, bool fill = false);
-
-        void OnDraw(Display& display, uint8_t x, uint8_t y, bool color) const override;
-
-        uint8_t GetRadius() const { return _radius; }
-
-        virtual Circle GetCircle() const { return {_x, _y, _radius}; }
-
-    protected:
-        uint8_t _radius;
-        bool _fill;
-};  
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+// Signed Q16.16 fixed-point number. Results that do not fit saturate
+// instead of wrapping, so a division by a tiny step still compares as
+// "very far away".
+class Fixed
+{
+public:
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr int32_t ONE = 1 << FRACTION_BITS;
+
+    constexpr Fixed() = default;
+    constexpr Fixed(int value) : _raw(value * ONE) {}
+    constexpr Fixed(float value)
+        : _raw(static_cast<int32_t>(value * ONE + (value < 0.f ? -0.5f : 0.5f))) {}
+
+    static constexpr Fixed FromRaw(int32_t raw)
+    {
+        Fixed result;
+        result._raw = raw;
+        return result;
+    }
+
+    constexpr int32_t Raw() const { return _raw; }
+    constexpr float ToFloat() const { return static_cast<float>(_raw) / ONE; }
+
+    constexpr Fixed operator-() const { return FromRaw(-_raw); }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) { return Saturate(int64_t(a._raw) + b._raw); }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) { return Saturate(int64_t(a._raw) - b._raw); }
+    friend constexpr Fixed operator*(Fixed a, Fixed b)
+    {
+        return Saturate((int64_t(a._raw) * b._raw) >> FRACTION_BITS);
+    }
+    friend constexpr Fixed operator/(Fixed a, Fixed b)
+    {
+        if (b._raw == 0)
+        {
+            return FromRaw(a._raw < 0 ? INT32_MIN : INT32_MAX);
+        }
+        return Saturate((int64_t(a._raw) * ONE) / b._raw);
+    }
+
+    constexpr Fixed& operator+=(Fixed other) { return *this = *this + other; }
+    constexpr Fixed& operator-=(Fixed other) { return *this = *this - other; }
+    constexpr Fixed& operator*=(Fixed other) { return *this = *this * other; }
+    constexpr Fixed& operator/=(Fixed other) { return *this = *this / other; }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a._raw == b._raw; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a._raw != b._raw; }
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a._raw < b._raw; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a._raw > b._raw; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a._raw <= b._raw; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a._raw >= b._raw; }
+
+private:
+    static constexpr Fixed Saturate(int64_t raw)
+    {
+        return FromRaw(raw > INT32_MAX ? INT32_MAX : raw < INT32_MIN ? INT32_MIN : static_cast<int32_t>(raw));
+    }
+
+    int32_t _raw = 0;
+};
+
+namespace std
+{
+    template<>
+    class numeric_limits<Fixed>
+    {
+    public:
+        static constexpr bool is_specialized = true;
+        static constexpr bool has_infinity = false;
+        static constexpr Fixed min() { return Fixed::FromRaw(1); }
+        static constexpr Fixed max() { return Fixed::FromRaw(INT32_MAX); }
+        static constexpr Fixed lowest() { return Fixed::FromRaw(INT32_MIN); }
+    };
+}
@@ -1,45 +1,50 @@
 #include "Game.h"
 
-#include "GameOver.h"
+#include "BounceTable.h"
+#include "Levels.h"
+#include "Profiler/Profiler.h"
+#include "Sprites.h"
 
 #include <algorithm>
-#include <cmath>
 
 constexpr float PRESS_TIMEOUT = 0.03f;
 constexpr float GAME_OVER_TIMEOUT = 1.f;
-constexpr uint8_t BRICK_WIDTH = 15;
-constexpr uint8_t BRICK_HEIGHT = 7;
-constexpr float BALL_SPEED = 90.f;
-constexpr float BALL_MIN_ANGLE = 30.f * PI / 180.f;
-constexpr float BALL_MAX_ANGLE = 150.f * PI / 180.f;
+constexpr Scalar BALL_SPEED = 90;
+// Every this many destroyed bricks, each ball in play splits in two.
+constexpr uint8_t BRICKS_PER_SPLIT = 6;
+// A ball moving straight up or down splits into two at this angle from
+// the vertical.
+constexpr double SPLIT_ANGLE = 30.0 * PI / 180.0;
+constexpr Scalar SPLIT_SIN = static_cast<float>(BounceTableDetail::Sin(SPLIT_ANGLE));
+constexpr Scalar SPLIT_COS = static_cast<float>(BounceTableDetail::Cos(SPLIT_ANGLE));
+constexpr double BALL_MIN_ANGLE = 30.0 * PI / 180.0;
+constexpr double BALL_MAX_ANGLE = 150.0 * PI / 180.0;
+constexpr BounceTable<BOUNCE_DIRECTIONS> BALL_BOUNCE_TABLE(BALL_MIN_ANGLE, BALL_MAX_ANGLE);
+constexpr int MAX_BALL_BOUNCES = 4;
+// Distance kept from a surface after a swept hit so that the discrete pass
+// does not see the same contact again.
+constexpr Scalar CONTACT_SKIN = 0.01f;
 
 
 void Game::Init()
 {
-    constexpr int columns = DISPLAY_WIDTH / (BRICK_WIDTH + 1);
-    constexpr int rows = 3;
-
-    _bricks.clear();
-    for (int i = 0; i < columns; ++i)
-    {
-        for (int j = 0; j < rows; ++j)
-        {
-            const uint8_t w = BRICK_WIDTH + 1;
-            const uint8_t h = BRICK_HEIGHT + 1;
-            const uint8_t x = i * w;
-            const uint8_t y = DISPLAY_HEIGHT - (j + 1) * h;
-            _bricks.push_back(Brick(x, y, BRICK_WIDTH, BRICK_HEIGHT, 3 - j));
-        }
-    }
+    _level = 0;
+    StartLevel();
+}
 
-    _ball = Ball();
-    _ball.SetVelocityX(0.f);
-    _ball.SetVelocityY(90.f);
+void Game::StartLevel()
+{
+    _bricks.Load(GetLevelLayout(_level));
+    _ballSpeed = BALL_SPEED;
+    _balls.Reset(0, _ballSpeed);
+    _bricksUntilSplit = BRICKS_PER_SPLIT;
     _platform = Platform();
 }
 
 void Game::Update(float dt)
 {
+    PROFILE_ZONE(Update);
+
     if (_pressTimeOut > 0.f)
     {
         _pressTimeOut -= dt;
@@ -58,43 +63,115 @@ void Game::Update(float dt)
         return;
     }
 
+    _balls.StorePreviousState();
+    _platform.StorePreviousState();
+
     UpdateCollisions();
+    if (_gameOverTimeOut > 0.f)
+    {
+        return;
+    }
 
-    _ball.Update(dt);
-    _platform.Update(dt);
-}
+    const Scalar step = dt;
+    const uint8_t nearBricks = GetBallsNearBricks(step);
+    _balls.ForEach([&](uint8_t ball)
+    {
+        MoveBall(ball, step, nearBricks & (1u << ball));
+    });
+    if (_balls.IsEmpty())
+    {
+        _gameOverTimeOut = GAME_OVER_TIMEOUT;
+    }
+    _platform.Update(step);
 
-void Game::Draw(Display& display)
-{
-    if (_needClearDisplay)
+    if (_bricksUntilSplit == 0)
     {
-        display.FillBlack();
-        _needClearDisplay = false;
+        SplitBalls();
+        _bricksUntilSplit = BRICKS_PER_SPLIT;
+    }
+
+    if (_bricks.IsEmpty())
+    {
+        _level = (_level + 1) % GetLevelCount();
+        _needClearDisplay = true;
+        StartLevel();
     }
+}
 
+void Game::Update(float dt, uint32_t inputTime)
+{
+    DrainInput(dt, inputTime);
+    Update(dt);
+}
+
+void Game::Draw(Display& display, float alpha)
+{
     if (_gameOverTimeOut > 0.f)
     {
-        display.DrawImage(GameOver);
+        display.DrawImage(Sprites::GameOver);
         display.UpdateScreen();
         return;
     }
 
-    for (const auto& rect : _rectsToClear)
+    _balls.Interpolate(alpha);
+    _platform.Interpolate(alpha);
+
+    if (_renderMode == RenderMode::PageCompose)
     {
-        display.DrawRect(rect.x, rect.y, rect.w, rect.h, false);
+        ComposePages(display);
+    }
+    else
+    {
+        DrawIncremental(display);
     }
 
-    _rectsToClear.clear();
+    display.UpdateScreen();
+}
 
-    for (auto& brick : _bricks)
+void Game::DrawIncremental(Display& display)
+{
+    if (_needClearDisplay)
     {
-        brick.Draw(display);
+        display.FillBlack();
+        _needClearDisplay = false;
     }
 
-    _ball.Draw(display);
+    _bricks.Draw(display);
+
+    _balls.Draw(display);
     _platform.Draw(display);
+}
 
-    display.UpdateScreen();
+void Game::ComposePages(Display& display)
+{
+    PROFILE_ZONE(DrawObject);
+
+    // One bit per page that has to be recomposed.
+    uint8_t pages = _needClearDisplay ? 0xFF : 0;
+    _needClearDisplay = false;
+
+    pages |= _bricks.GetRedrawPages();
+    pages |= _balls.GetRedrawPages();
+    pages |= _platform.GetRedrawPages();
+
+    for (uint8_t page = 0; page < DISPLAY_PAGES; ++page)
+    {
+        if ((pages & (1u << page)) == 0)
+        {
+            continue;
+        }
+
+        PageLine line(page);
+        _bricks.DrawPage(line);
+        _balls.DrawPage(line);
+        _platform.DrawPage(line);
+
+        display.WritePage(page, line.Data());
+    }
+
+    _bricks.MarkDrawn();
+    _balls.MarkDrawn();
+    _platform.MarkDrawn();
 }
 
 void Game::OnLeftPressed()
@@ -109,91 +186,312 @@ void Game::OnRightPressed()
     _pressTimeOut = PRESS_TIMEOUT;
 }
 
-void Game::UpdateCollisions()
+void Game::DrainInput(float dt, uint32_t inputTime)
 {
-    const Circle ballCircle = _ball.GetCircle();
-    const Rect platformRect = _platform.GetRect();
+    constexpr size_t buttons = static_cast<size_t>(Button::Count);
+    const uint32_t stepTicks = static_cast<uint32_t>(dt * Input::TicksPerSecond() + 0.5f);
+    const uint32_t stepStart = inputTime - stepTicks;
 
-    if (Intersects(ballCircle, platformRect))
+    std::array<uint32_t, buttons> heldTicks{};
+    std::array<uint32_t, buttons> since;
+    since.fill(stepStart);
+
+    // Later events stay queued for the step they fall into.
+    InputEvent event;
+    while (Input::Peek(event) && static_cast<int32_t>(event.time - inputTime) <= 0)
     {
-        const float t = 1.f - std::clamp((ballCircle.x - platformRect.x) / platformRect.w, 0.f, 1.f);
-        const float angle = Lerp(BALL_MIN_ANGLE, BALL_MAX_ANGLE, t);
-        const float velocityX = BALL_SPEED * std::cos(angle);
-        const float velocityY = BALL_SPEED * std::sin(angle);
-        _ball.SetVelocityX(velocityX);
-        _ball.SetVelocityY(velocityY);
-        _ball.SetYF(platformRect.y + platformRect.h + ballCircle.r);
+        Input::Pop();
 
-        _platform.SetDirty(true);
+        const size_t button = static_cast<size_t>(event.button);
+        const uint32_t time = static_cast<int32_t>(event.time - stepStart) > 0 ? event.time : stepStart;
+        if (_buttonDown[button])
+        {
+            heldTicks[button] += time - since[button];
+        }
+        since[button] = time;
+        _buttonDown[button] = event.pressed;
     }
-    else
+
+    for (size_t button = 0; button < buttons; ++button)
     {
-        if (IntersectsHorizontalWall(ballCircle, 0)) // bottom wall
+        if (_buttonDown[button])
         {
-            _gameOverTimeOut = GAME_OVER_TIMEOUT;
-            return;
+            heldTicks[button] += inputTime - since[button];
         }
+    }
+
+    const float ticksPerSecond = static_cast<float>(Input::TicksPerSecond());
+    _platform.AddHeldTime(heldTicks[static_cast<size_t>(Button::Left)] / ticksPerSecond,
+                          heldTicks[static_cast<size_t>(Button::Right)] / ticksPerSecond);
+}
+
+void Game::UpdateCollisions()
+{
+    PROFILE_ZONE(UpdateCollisions);
+
+    const Rect platformRect = _platform.GetRect();
+    const uint8_t nearBricks = GetBallsNearBricks(0);
+    std::array<Circle, MAX_BALLS> ballCircles;
+
+    // Platform and walls, for every ball.
+    _balls.ForEach([&](uint8_t ball)
+    {
+        const Circle ballCircle = _balls.GetCircle(ball);
+        ballCircles[ball] = ballCircle;
 
-        if (IntersectsHorizontalWall(ballCircle, DISPLAY_HEIGHT - 1)) // top wall
+        if (Intersects(ballCircle, platformRect))
+        {
+            BounceOffPlatform(ball, ballCircle, platformRect);
+            _balls.y[ball] = platformRect.y + platformRect.h + ballCircle.r;
+        }
+        else if (IntersectsHorizontalWall(ballCircle, 0)) // bottom wall
+        {
+            _balls.Remove(ball);
+        }
+        else if (IntersectsHorizontalWall(ballCircle, DISPLAY_HEIGHT - 1)) // top wall
         {
-            _ball.SetVelocityY(-std::fabs(_ball.GetVelocityY()));
+            _balls.dy[ball] = -Abs(_balls.dy[ball]);
         }
         else if (IntersectsVerticalWall(ballCircle, DISPLAY_WIDTH - 1)) // right wall
         {
-            _ball.SetVelocityX(-std::fabs(_ball.GetVelocityX()));
+            _balls.dx[ball] = -Abs(_balls.dx[ball]);
         }
-        else if (IntersectsVerticalWall(_ball.GetCircle(), 0)) // left wall
+        else if (IntersectsVerticalWall(ballCircle, 0)) // left wall
         {
-            _ball.SetVelocityX(std::fabs(_ball.GetVelocityX()));
+            _balls.dx[ball] = Abs(_balls.dx[ball]);
         }
-    }
+    });
 
-    bool brickHit = false;
+    if (_balls.IsEmpty())
+    {
+        _gameOverTimeOut = GAME_OVER_TIMEOUT;
+        return;
+    }
 
-    for (size_t i = 0; i < _bricks.size(); ++i)
+    // Bricks; each ball takes at most one hit per step.
+    _balls.ForEach([&](uint8_t ball)
     {
-        Brick& brick = _bricks[i];
-        const Rect brickRect = brick.GetRect();
-        const CollisionSide side = GetCollisionSide(ballCircle, brickRect);
+        if ((nearBricks & (1u << ball)) == 0)
+        {
+            return;
+        }
+
+        const Circle& ballCircle = ballCircles[ball];
+        bool brickHit = false;
 
-        if (side != CollisionSide::None)
+        // Brick rects reach half a pixel outside their cell.
+        const Rect ballArea = {ballCircle.x - ballCircle.r - 0.5f, ballCircle.y - ballCircle.r - 0.5f,
+                               2 * ballCircle.r + 1, 2 * ballCircle.r + 1};
+
+        _bricks.ForEachInArea(ballArea, [&](uint8_t column, uint8_t row)
         {
-            brick.SetDirty(true);
-            if (!brickHit)
-            {
-                brickHit = true;
-                brick.OnHit();
-                _rectsToClear.push_back(brick.GetRectToClear());
+            const Rect brickRect = BrickField::GetCellRect(column, row);
+            const CollisionSide side = GetCollisionSide(ballCircle, brickRect);
 
-                switch (side)
+            if (side != CollisionSide::None)
+            {
+                _bricks.MarkDirty(column, row);
+                if (!brickHit)
                 {
-                    case CollisionSide::Top:
-                        _ball.SetVelocityY(std::fabs(_ball.GetVelocityY()));
-                        _ball.SetYF(brickRect.y + brickRect.h + ballCircle.r);
-                        break;
-                    case CollisionSide::Bottom:
-                        _ball.SetVelocityY(-std::fabs(_ball.GetVelocityY()));
-                        _ball.SetYF(brickRect.y - ballCircle.r);
-                        break;
-                    case CollisionSide::Left:
-                        _ball.SetVelocityX(-std::fabs(_ball.GetVelocityX()));
-                        _ball.SetXF(brickRect.x - ballCircle.r);
-                        break;
-                    case CollisionSide::Right:
-                        _ball.SetVelocityX(std::fabs(_ball.GetVelocityX()));
-                        _ball.SetXF(brickRect.x + brickRect.w + ballCircle.r);
-                        break;
-                    default:
-                        break;
+                    brickHit = true;
+                    HitBrick(column, row);
+
+                    ReflectBall(ball, side);
+                    switch (side)
+                    {
+                        case CollisionSide::Top:
+                            _balls.y[ball] = brickRect.y + brickRect.h + ballCircle.r;
+                            break;
+                        case CollisionSide::Bottom:
+                            _balls.y[ball] = brickRect.y - ballCircle.r;
+                            break;
+                        case CollisionSide::Left:
+                            _balls.x[ball] = brickRect.x - ballCircle.r;
+                            break;
+                        case CollisionSide::Right:
+                            _balls.x[ball] = brickRect.x + brickRect.w + ballCircle.r;
+                            break;
+                        default:
+                            break;
+                    }
                 }
             }
+        });
+    });
+}
+
+void Game::MoveBall(uint8_t ball, Scalar dt, bool nearBricks)
+{
+    // Advance to the first contact along the path, respond, and continue
+    // with the rest of the step, so fast balls and long frames cannot
+    // tunnel through bricks or the platform.
+    Scalar remaining = dt;
+
+    for (int bounce = 0; bounce <= MAX_BALL_BOUNCES && remaining > 0; ++bounce)
+    {
+        const Circle ballCircle = _balls.GetCircle(ball);
+        const Scalar dx = _balls.dx[ball] * remaining;
+        const Scalar dy = _balls.dy[ball] * remaining;
+
+        const Contact contact = FindFirstContact(ballCircle, dx, dy, nearBricks);
+        if (contact.kind == ContactKind::None || bounce == MAX_BALL_BOUNCES)
+        {
+            _balls.MoveBy(ball, dx, dy);
+            break;
+        }
+
+        const Scalar length = Sqrt(dx * dx + dy * dy);
+        const Scalar t = std::max<Scalar>(0, contact.toi - CONTACT_SKIN / length);
+        _balls.MoveBy(ball, dx * t, dy * t);
+        remaining *= 1 - contact.toi;
+
+        switch (contact.kind)
+        {
+            case ContactKind::Floor:
+                _balls.Remove(ball);
+                remaining = 0;
+                break;
+            case ContactKind::Platform:
+                BounceOffPlatform(ball, _balls.GetCircle(ball), _platform.GetRect());
+                break;
+            case ContactKind::Brick:
+                HitBrick(contact.brickColumn, contact.brickRow);
+                ReflectBall(ball, contact.side);
+                break;
+            default:
+                ReflectBall(ball, contact.side);
+                break;
+        }
+    }
+}
+
+uint8_t Game::GetBallsNearBricks(Scalar dt) const
+{
+    ByteBox bricks;
+    if (!_bricks.GetBounds(bricks))
+    {
+        return 0;
+    }
+
+    // However it bounces, a ball stays within its path length of where it
+    // started; a platform bounce can change its speed to the launch speed.
+    const Scalar distance = std::max(_balls.GetMaxSpeed(), _ballSpeed) * dt;
+
+    uint8_t near = 0;
+    for (uint8_t first = 0; first < MAX_BALLS; first += 4)
+    {
+        near |= Broadphase::Overlaps4(_balls.GetBoxes4(first, distance), bricks) << first;
+    }
+    return near;
+}
+
+Game::Contact Game::FindFirstContact(const Circle& ballCircle, Scalar dx, Scalar dy, bool nearBricks) const
+{
+    Contact contact;
+    Scalar toi = 0;
+
+    // Walls, as the side of the ball that touches them.
+    if (SweepCircleVerticalWall(ballCircle, dx, 0, toi) && toi < contact.toi)
+    {
+        contact = {ContactKind::Wall, CollisionSide::Right, toi};
+    }
+    if (SweepCircleVerticalWall(ballCircle, dx, DISPLAY_WIDTH - 1, toi) && toi < contact.toi)
+    {
+        contact = {ContactKind::Wall, CollisionSide::Left, toi};
+    }
+    if (SweepCircleHorizontalWall(ballCircle, dy, DISPLAY_HEIGHT - 1, toi) && toi < contact.toi)
+    {
+        contact = {ContactKind::Wall, CollisionSide::Bottom, toi};
+    }
+    if (SweepCircleHorizontalWall(ballCircle, dy, 0, toi) && toi < contact.toi)
+    {
+        contact = {ContactKind::Floor, CollisionSide::Top, toi};
+    }
+
+    CollisionSide side = CollisionSide::None;
+    if (SweepCircleRect(ballCircle, dx, dy, _platform.GetRect(), toi, side) && toi <= contact.toi)
+    {
+        contact = {ContactKind::Platform, side, toi};
+    }
+
+    if (!nearBricks)
+    {
+        return contact;
+    }
+
+    // Only the cells swept by the ball can hold a brick it reaches.
+    const Rect sweptArea = {std::min(ballCircle.x, ballCircle.x + dx) - ballCircle.r - 0.5f,
+                            std::min(ballCircle.y, ballCircle.y + dy) - ballCircle.r - 0.5f,
+                            Abs(dx) + 2 * ballCircle.r + 1,
+                            Abs(dy) + 2 * ballCircle.r + 1};
+
+    _bricks.ForEachInArea(sweptArea, [&](uint8_t column, uint8_t row)
+    {
+        if (SweepCircleRect(ballCircle, dx, dy, BrickField::GetCellRect(column, row), toi, side)
+            && toi < contact.toi)
+        {
+            contact = {ContactKind::Brick, side, toi, column, row};
         }
+    });
+
+    return contact;
+}
+
+void Game::ReflectBall(uint8_t ball, CollisionSide side)
+{
+    switch (side)
+    {
+        case CollisionSide::Top:
+            _balls.dy[ball] = Abs(_balls.dy[ball]);
+            break;
+        case CollisionSide::Bottom:
+            _balls.dy[ball] = -Abs(_balls.dy[ball]);
+            break;
+        case CollisionSide::Left:
+            _balls.dx[ball] = -Abs(_balls.dx[ball]);
+            break;
+        case CollisionSide::Right:
+            _balls.dx[ball] = Abs(_balls.dx[ball]);
+            break;
+        default:
+            break;
     }
+}
+
+void Game::BounceOffPlatform(uint8_t ball, const Circle& ballCircle, const Rect& platformRect)
+{
+    const Scalar t = 1 - std::clamp<Scalar>((ballCircle.x - platformRect.x) / platformRect.w, 0, 1);
+    const int direction = BALL_BOUNCE_TABLE.Index(t);
+    _balls.dx[ball] = _ballSpeed * BALL_BOUNCE_TABLE.x[direction];
+    _balls.dy[ball] = _ballSpeed * BALL_BOUNCE_TABLE.y[direction];
+
+    _platform.SetDirty(true);
+}
 
-    if (brickHit)
+void Game::HitBrick(uint8_t column, uint8_t row)
+{
+    _bricks.Hit(column, row);
+    if (_bricks.GetLevel(column, row) == 0 && _bricksUntilSplit > 0)
     {
-        _bricks.erase(std::remove_if(_bricks.begin(), _bricks.end(), [](const Brick& brick) {
-            return brick.GetLevel() == 0;
-        }), _bricks.end());
+        _bricksUntilSplit--;
     }
+}
+
+void Game::SplitBalls()
+{
+    // The new ball leaves mirrored around the vertical.
+    _balls.ForEach([&](uint8_t ball)
+    {
+        Scalar dx = _balls.dx[ball];
+        Scalar dy = _balls.dy[ball];
+        if (dx == 0)
+        {
+            dx = dy * SPLIT_SIN;
+            dy = dy * SPLIT_COS;
+            _balls.dx[ball] = dx;
+            _balls.dy[ball] = dy;
+        }
+
+        _balls.Spawn(_balls.x[ball], _balls.y[ball], -dx, dy);
+    });
 }
\ No newline at end of file
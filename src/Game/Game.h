@@ -1,30 +1,91 @@
 #pragma once
 
-#include <vector>
-#include <memory>
-
 #include "ssd1306/Display.h"
+#include "BrickField.h"
 #include "GameObjects.h"
+#include "Input/Input.h"
+
+enum class RenderMode
+{
+    // Objects erase their previous position and draw the new one.
+    Incremental,
+    // Every page touched by a change is recomposed from scratch.
+    PageCompose
+};
 
 class Game
 {
 public:
+    // Rate of the fixed simulation step used by the main loop, and the most
+    // steps it runs to catch up after a long frame.
+    static constexpr uint32_t STEP_RATE = 240;
+    static constexpr float STEP_DT = 1.f / STEP_RATE;
+    static constexpr uint32_t MAX_CATCH_UP_STEPS = 8;
+
     void Init();
     void Update(float dt);
-    void Draw(Display& display);
+    // Applies the button events up to inputTime, the Input clock at the end
+    // of the step, then updates. The platform moves for as long as each
+    // button was actually held during the step.
+    void Update(float dt, uint32_t inputTime);
+    // alpha is the fraction of a step elapsed since the last Update.
+    void Draw(Display& display, float alpha = 1.f);
+    void SetRenderMode(RenderMode mode) { _renderMode = mode; }
+    RenderMode GetRenderMode() const { return _renderMode; }
     void OnLeftPressed();
     void OnRightPressed();
 
+    // Speed the ball leaves the platform with; reset when a level starts.
+    void SetBallSpeed(Scalar speed) { _ballSpeed = speed; }
+    Scalar GetBallSpeed() const { return _ballSpeed; }
+
 private:
+    friend class GameBenchmark;
+
+    enum class ContactKind
+    {
+        None,
+        Wall,
+        Floor,
+        Platform,
+        Brick
+    };
+
+    struct Contact
+    {
+        ContactKind kind = ContactKind::None;
+        CollisionSide side = CollisionSide::None;
+        Scalar toi = 1;
+        uint8_t brickColumn = 0;
+        uint8_t brickRow = 0;
+    };
+
+    // Loads the current level and puts the ball and platform back.
+    void StartLevel();
+    void DrainInput(float dt, uint32_t inputTime);
+    void DrawIncremental(Display& display);
+    void ComposePages(Display& display);
     void UpdateCollisions();
+    void MoveBall(uint8_t ball, Scalar dt, bool nearBricks);
+    // Mask of the balls that can reach a brick within dt.
+    uint8_t GetBallsNearBricks(Scalar dt) const;
+    Contact FindFirstContact(const Circle& ballCircle, Scalar dx, Scalar dy, bool nearBricks) const;
+    void ReflectBall(uint8_t ball, CollisionSide side);
+    void BounceOffPlatform(uint8_t ball, const Circle& ballCircle, const Rect& platformRect);
+    void HitBrick(uint8_t column, uint8_t row);
+    void SplitBalls();
 
-    std::vector<Brick> _bricks;
-    std::vector<Rect> _rectsToClear;
-    Ball _ball;
+    BrickField _bricks;
+    Balls _balls;
     Platform _platform;
+    Scalar _ballSpeed = 0;
+    uint8_t _bricksUntilSplit = 0;
+    uint8_t _level = 0;
+    std::array<bool, static_cast<size_t>(Button::Count)> _buttonDown{};
     float _pressTimeOut  = 0.f;
     float _gameOverTimeOut = 0.f;
     bool _needClearDisplay = false;
+    RenderMode _renderMode = RenderMode::Incremental;
 };
 
 bool CircleIntersectsRect(float cx, float cy, float radius,
@@ -1,101 +1,209 @@
 #include "GameObjects.h"
 
-#include "Bricks.h"
+#include "Sprites.h"
 
 #include <algorithm>
-#include <cmath>
 
 
 constexpr uint8_t FIELD_WIDTH = 128;
 constexpr uint8_t FIELD_HEIGHT = 64;
-constexpr float PLATFORM_SPEED = 160.f;
+constexpr Scalar PLATFORM_SPEED = 160;
 constexpr uint8_t BALL_RADIUS = 2;
-constexpr bool BALL_FILL = true;
-constexpr uint8_t BRICK_WIDTH = 7;
-constexpr uint8_t BRICK_HEIGHT = 3;
 constexpr uint8_t PLATFORM_WIDTH = 20;
 constexpr uint8_t PLATFORM_HEIGHT = 3;
 constexpr uint8_t BALL_START_X = DISPLAY_WIDTH / 2 - 1;
 constexpr uint8_t BALL_START_Y = PLATFORM_HEIGHT + 5;
 
-Ball::Ball()
-    : DrawCircleObject(BALL_START_X, BALL_START_Y, BALL_RADIUS, BALL_FILL)
+void Balls::Reset(Scalar dx, Scalar dy)
 {
-    _xf = static_cast<float>(_x);
-    _yf = static_cast<float>(_y);
+    _active = 0;
+    _drawn = 0;
+    Spawn(BALL_START_X, BALL_START_Y, dx, dy);
 }
 
-void Ball::Update(float dt)
+int Balls::Spawn(Scalar newX, Scalar newY, Scalar newDx, Scalar newDy)
 {
-    _xf += _dx * dt;
-    _yf += _dy * dt;
+    const uint32_t free = ~_active & ((1u << MAX_BALLS) - 1);
+    if (free == 0)
+    {
+        return -1;
+    }
 
-    _x = std::round(_xf);
-    _y = std::round(_yf);
+    const uint8_t slot = LowestBit(free);
+    x[slot] = newX;
+    y[slot] = newY;
+    dx[slot] = newDx;
+    dy[slot] = newDy;
+    _prevX[slot] = newX;
+    _prevY[slot] = newY;
+    _screenX[slot] = RoundToInt(newX);
+    _screenY[slot] = RoundToInt(newY);
+    _active |= 1u << slot;
+    return slot;
 }
 
-Platform::Platform() : DrawRectObject((FIELD_WIDTH - PLATFORM_WIDTH) / 2, 0, PLATFORM_WIDTH, PLATFORM_HEIGHT)
+Circle Balls::GetCircle(uint8_t slot) const
 {
-    _xf = static_cast<float>(_x);
+    return {x[slot], y[slot], Scalar(BALL_RADIUS + 1)};
 }
 
-void Platform::Update(float dt)
+ByteBoxes4 Balls::GetBoxes4(uint8_t first, Scalar distance) const
 {
-    if (_leftPressed)
-    {
-        _xf -= PLATFORM_SPEED * dt;
-        _leftPressed = false;
-    }
-    if (_rightPressed)
+    auto toByte = [](int value) { return static_cast<uint8_t>(std::clamp(value, 0, 255)); };
+
+    ByteBoxes4 boxes;
+    for (uint8_t lane = 0; lane < 4; ++lane)
     {
-        _xf += PLATFORM_SPEED * dt;
-        _rightPressed = false;
+        const uint8_t slot = first + lane;
+        if ((_active & (1u << slot)) == 0)
+        {
+            continue;
+        }
+
+        const Circle circle = GetCircle(slot);
+        const Scalar reach = circle.r + 0.5f + distance;
+        boxes.Set(lane, {toByte(Floor(circle.x - reach)), toByte(Floor(circle.y - reach)),
+                         toByte(Floor(circle.x + reach) + 1), toByte(Floor(circle.y + reach) + 1)});
     }
+    return boxes;
+}
 
-    _xf = std::clamp(_xf, 0.f, static_cast<float>(FIELD_WIDTH - _width));
-    _x = std::round(_xf);
+Scalar Balls::GetMaxSpeed() const
+{
+    Scalar speed = 0;
+    ForEach([&](uint8_t slot)
+    {
+        speed = std::max(speed, Abs(dx[slot]) + Abs(dy[slot]));
+    });
+    return speed;
 }
 
-Brick::Brick(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t level)
-    : DrawRectObject(x, y, w, h)
+void Balls::StorePreviousState()
 {
-    _level = level;
+    _prevX = x;
+    _prevY = y;
 }
 
-void Brick::OnDraw(Display& display, uint8_t x, uint8_t y, bool color) const
+void Balls::Interpolate(float alpha)
 {
-    const uint8_t* image = nullptr;
-    size_t imageSize = 0;
+    ForEach([&](uint8_t slot)
+    {
+        _screenX[slot] = RoundToInt(Lerp(_prevX[slot], x[slot], alpha));
+        _screenY[slot] = RoundToInt(Lerp(_prevY[slot], y[slot], alpha));
+    });
+}
 
-    switch (_level)
+bool Balls::NeedsRedraw(uint8_t slot) const
+{
+    const uint8_t bit = 1u << slot;
+    if ((_active & bit) != (_drawn & bit))
     {
-        default:
-        case 1:
-            image = Brick01.data();
-            imageSize = Brick01.size();
-            break;
-        case 2:
-            image = Brick02.data();
-            imageSize = Brick02.size();
-            break;
-        case 3:
-            image = Brick03.data();
-            imageSize = Brick03.size();
-            break;
+        return true;
     }
 
-    if (color)
+    return (_active & bit) && (_screenX[slot] != _drawnX[slot] || _screenY[slot] != _drawnY[slot]);
+}
+
+void Balls::Draw(Display& display)
+{
+    PROFILE_ZONE(DrawObject);
+
+    const Sprite& sprite = Sprites::Ball;
+    bool erased = false;
+
+    for (uint32_t bits = _drawn; bits != 0; bits &= bits - 1)
     {
-        display.DrawImage(x, y / 8u, image, imageSize, 1);
+        const uint8_t slot = LowestBit(bits);
+        if (NeedsRedraw(slot))
+        {
+            display.DrawSprite(_drawnX[slot] - sprite.width / 2, _drawnY[slot] - sprite.height / 2,
+                               sprite, BlitMode::Clear);
+            erased = true;
+        }
     }
-    else
+
+    // Erasing one ball can cut into another, so after an erase every ball
+    // is drawn again; unchanged pixels cost nothing to send.
+    ForEach([&](uint8_t slot)
+    {
+        if (erased || NeedsRedraw(slot))
+        {
+            display.DrawSprite(_screenX[slot] - sprite.width / 2, _screenY[slot] - sprite.height / 2,
+                               sprite, BlitMode::Set);
+        }
+    });
+
+    MarkDrawn();
+}
+
+uint8_t Balls::GetRedrawPages() const
+{
+    const int offset = -(Sprites::Ball.height / 2);
+    const int height = Sprites::Ball.height;
+    uint8_t pages = 0;
+
+    for (uint32_t bits = _active | _drawn; bits != 0; bits &= bits - 1)
     {
-        display.DrawRect(x, y, _width + 1, _height + 1, false);
+        const uint8_t slot = LowestBit(bits);
+        if (!NeedsRedraw(slot))
+        {
+            continue;
+        }
+        if (_drawn & (1u << slot))
+        {
+            pages |= RowPages(_drawnY[slot] + offset, height);
+        }
+        if (_active & (1u << slot))
+        {
+            pages |= RowPages(_screenY[slot] + offset, height);
+        }
     }
+    return pages;
+}
+
+void Balls::DrawPage(PageLine& line) const
+{
+    const Sprite& sprite = Sprites::Ball;
+
+    ForEach([&](uint8_t slot)
+    {
+        const int top = _screenY[slot] - sprite.height / 2;
+        if (line.IntersectsRows(top, sprite.height))
+        {
+            line.DrawSprite(_screenX[slot] - sprite.width / 2, top, sprite, BlitMode::Set);
+        }
+    });
+}
+
+void Balls::MarkDrawn()
+{
+    _drawnX = _screenX;
+    _drawnY = _screenY;
+    _drawn = _active;
+}
+
+Platform::Platform() : DrawRectObject<Platform>((FIELD_WIDTH - PLATFORM_WIDTH) / 2, 0, PLATFORM_WIDTH, PLATFORM_HEIGHT)
+{
+    _xf = _x;
+    StorePreviousState();
+}
+
+void Platform::Update(Scalar dt)
+{
+    const Scalar left = _leftPressed ? dt : std::min(_leftHeld, dt);
+    const Scalar right = _rightPressed ? dt : std::min(_rightHeld, dt);
+    _xf += PLATFORM_SPEED * (right - left);
+
+    _leftPressed = false;
+    _rightPressed = false;
+    _leftHeld = 0;
+    _rightHeld = 0;
+
+    _xf = std::clamp<Scalar>(_xf, 0, FIELD_WIDTH - _width);
+    _x = RoundToInt(_xf);
 }
 
-void Brick::OnHit()
+void Platform::Interpolate(float alpha)
 {
-    _level--;
-    SetDirty(true);
+    _x = RoundToInt(Lerp(_prevXf, _xf, alpha));
 }
@@ -1,66 +1,114 @@
 #pragma once
 
+#include "Broadphase.h"
 #include "DrawObjects.h"
 
-class Ball : public DrawCircleObject
+#include <array>
+
+constexpr uint8_t MAX_BALLS = 8;
+
+// Every ball in play, stored as parallel arrays so that each pass over the
+// balls is one loop. A ball keeps its slot while in play; one mask tells
+// which slots are in play and another which are on screen.
+class Balls
 {
 public:
-    Ball();
+    static_assert(MAX_BALLS <= 8, "Ball masks are one byte");
+    static_assert(MAX_BALLS % 4 == 0, "The broad phase takes balls in fours");
 
-    void SetXF(float xf) { _xf = xf; }
-    void SetYF(float yf) { _yf = yf; }
-    float GetXF() const { return _xf; }
-    float GetYF() const { return _yf; }
+    // Leaves a single ball at the start position, moving with (dx, dy).
+    void Reset(Scalar dx, Scalar dy);
+    // Slot of the new ball, or -1 when every slot is in play.
+    int Spawn(Scalar x, Scalar y, Scalar dx, Scalar dy);
+    void Remove(uint8_t slot) { _active &= ~(1u << slot); }
 
-    void SetVelocityX(float dx) { _dx = dx; }
-    void SetVelocityY(float dy) { _dy = dy; }
-    float GetVelocityX() const { return _dx; }
-    float GetVelocityY() const { return _dy; }
+    bool IsEmpty() const { return _active == 0; }
+    int GetCount() const { return __builtin_popcount(_active); }
 
-    Circle GetCircle() const override { return {_xf, _yf, _radius + 1.f}; }
+    // Calls func(slot) for every ball in play; func may remove or spawn balls.
+    template<typename Func>
+    void ForEach(Func func) const
+    {
+        for (uint32_t bits = _active; bits != 0; bits &= bits - 1)
+        {
+            func(static_cast<uint8_t>(LowestBit(bits)));
+        }
+    }
 
-    void Update(float dt);
-private:
-    float _dx;
-    float _dy;
-    float _xf;
-    float _yf;
-};
+    Circle GetCircle(uint8_t slot) const;
+    // Pixel boxes of the balls in slots first to first + 3, grown by
+    // distance on every side. Slots not in play overlap nothing.
+    ByteBoxes4 GetBoxes4(uint8_t first, Scalar distance) const;
+    // Largest |dx| + |dy| of the balls in play.
+    Scalar GetMaxSpeed() const;
 
-class Platform : public DrawRectObject
-{
-public:
-    Platform();
+    void MoveBy(uint8_t slot, Scalar moveX, Scalar moveY)
+    {
+        x[slot] += moveX;
+        y[slot] += moveY;
+    }
 
-    void Update(float dt);
+    // Render interpolation between the state before the last simulation
+    // step and the current one.
+    void StorePreviousState();
+    void Interpolate(float alpha);
 
-    void SetLeftPressed(bool leftPressed) { _leftPressed = leftPressed; }
-    void SetRightPressed(bool rightPressed) { _rightPressed = rightPressed; }
+    void Draw(Display& display);
+    uint8_t GetRedrawPages() const;
+    void DrawPage(PageLine& line) const;
+    void MarkDrawn();
+
+    std::array<Scalar, MAX_BALLS> x{};
+    std::array<Scalar, MAX_BALLS> y{};
+    std::array<Scalar, MAX_BALLS> dx{};
+    std::array<Scalar, MAX_BALLS> dy{};
 
 private:
-    float _xf;
-    bool _leftPressed = false;
-    bool _rightPressed = false;
+    bool NeedsRedraw(uint8_t slot) const;
+
+    std::array<Scalar, MAX_BALLS> _prevX{};
+    std::array<Scalar, MAX_BALLS> _prevY{};
+    // Interpolated position to draw, and the one drawn last.
+    std::array<uint8_t, MAX_BALLS> _screenX{};
+    std::array<uint8_t, MAX_BALLS> _screenY{};
+    std::array<uint8_t, MAX_BALLS> _drawnX{};
+    std::array<uint8_t, MAX_BALLS> _drawnY{};
+    uint8_t _active = 0;
+    uint8_t _drawn = 0;
 };
 
-class Brick : public DrawRectObject
+class Platform : public DrawRectObject<Platform>
 {
 public:
-    Brick(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t level);
-
-    Rect GetRect() const override { return {_x - 0.5f, _y - 0.5f, _width + 1.f, _height + 1.f}; }
-    Rect GetRectToClear() const { return {_x, _y, _width + 1.f, _height + 1.f}; }
-    uint8_t GetLevel() const { return _level; }
+    Platform();
 
-    void OnDraw(Display& display, uint8_t x, uint8_t y, bool color) const override;
+    void Update(Scalar dt);
 
-    void OnHit();
+    void SetLeftPressed(bool leftPressed) { _leftPressed = leftPressed; }
+    void SetRightPressed(bool rightPressed) { _rightPressed = rightPressed; }
+    // Time each button was held during the coming step; a button set as
+    // pressed counts as held for the whole step.
+    void AddHeldTime(Scalar left, Scalar right)
+    {
+        _leftHeld += left;
+        _rightHeld += right;
+    }
 
-    bool operator==(const Brick& other) const
+    // Collisions use the simulated position, not the interpolated one drawn.
+    Rect GetRect() const
     {
-        return _x == other._x && _y == other._y;
+        return {Round(_xf), static_cast<Scalar>(_y), static_cast<Scalar>(_width),
+                static_cast<Scalar>(_height)};
     }
 
+    void StorePreviousState() { _prevXf = _xf; }
+    void Interpolate(float alpha);
+
 private:
-    uint8_t _level = 1;
+    Scalar _xf;
+    Scalar _prevXf;
+    Scalar _leftHeld = 0;
+    Scalar _rightHeld = 0;
+    bool _leftPressed = false;
+    bool _rightPressed = false;
 };
\ No newline at end of file
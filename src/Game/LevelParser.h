@@ -0,0 +1,76 @@
+#pragma once
+
+#include "BrickField.h"
+
+#include <cstdint>
+#include <string_view>
+
+// A level written as text: rows of cells from the top of the screen down,
+// separated by whitespace. A cell is '.' for no brick or its level '1'-'3'.
+// The parser runs at compile time; it records what is wrong with the text
+// so the level table can static_assert on it.
+struct ParsedLevel
+{
+    LevelLayout layout{};
+    // Counted in size_t so that no text, however long, can wrap them back
+    // into range.
+    size_t rows = 0;
+    // Cells in the narrowest and widest row.
+    size_t minWidth = SIZE_MAX;
+    size_t maxWidth = 0;
+    bool badCells = false;
+};
+
+constexpr bool IsLevelSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+constexpr ParsedLevel ParseLevel(std::string_view text)
+{
+    ParsedLevel result;
+    size_t i = 0;
+
+    while (true)
+    {
+        while (i < text.size() && IsLevelSpace(text[i]))
+        {
+            ++i;
+        }
+        if (i == text.size())
+        {
+            break;
+        }
+
+        uint16_t row = 0;
+        size_t width = 0;
+        for (; i < text.size() && !IsLevelSpace(text[i]); ++i, ++width)
+        {
+            const char c = text[i];
+            uint16_t level = 0;
+            if (c >= '1' && c <= '0' + BrickField::MAX_LEVEL)
+            {
+                level = c - '0';
+            }
+            else if (c != '.')
+            {
+                result.badCells = true;
+            }
+
+            if (width < BrickField::COLUMNS)
+            {
+                row |= level << (width * 2);
+            }
+        }
+
+        result.minWidth = std::min(result.minWidth, width);
+        result.maxWidth = std::max(result.maxWidth, width);
+        if (result.rows < BrickField::ROWS)
+        {
+            result.layout.rows[BrickField::ROWS - 1 - result.rows] = row;
+        }
+        ++result.rows;
+    }
+
+    return result;
+}
@@ -0,0 +1,79 @@
+#include "Levels.h"
+
+#include "LevelParser.h"
+
+namespace
+{
+    // The bottom rows are left free for the platform and the ball.
+    constexpr uint8_t FREE_ROWS = 3;
+
+    constexpr std::array<ParsedLevel, 3> PARSED_LEVELS = {
+        ParseLevel(R"(
+            33333333
+            22222222
+            11111111
+        )"),
+        ParseLevel(R"(
+            3.3.3.3.
+            .2.2.2.2
+            1.1.1.1.
+            .1.1.1.1
+        )"),
+        ParseLevel(R"(
+            12333321
+            .123321.
+            ..1221..
+            ...11...
+        )"),
+    };
+
+    template<typename Predicate>
+    constexpr bool AllLevels(Predicate predicate)
+    {
+        for (const ParsedLevel& level : PARSED_LEVELS)
+        {
+            if (!predicate(level))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(AllLevels([](const ParsedLevel& level) { return !level.badCells; }),
+                  "Level cells must be '.' or a brick level from '1' to '3'");
+    static_assert(AllLevels([](const ParsedLevel& level)
+                  {
+                      return level.minWidth == DISPLAY_WIDTH / BRICK_CELL_WIDTH
+                          && level.maxWidth == DISPLAY_WIDTH / BRICK_CELL_WIDTH;
+                  }),
+                  "Every level row must have DISPLAY_WIDTH / BRICK_CELL_WIDTH cells");
+    static_assert(AllLevels([](const ParsedLevel& level)
+                  {
+                      return level.rows > 0 && level.rows <= BrickField::ROWS - FREE_ROWS;
+                  }),
+                  "A level must have between 1 and BrickField::ROWS - FREE_ROWS rows");
+
+    constexpr std::array<LevelLayout, PARSED_LEVELS.size()> MakeLayouts()
+    {
+        std::array<LevelLayout, PARSED_LEVELS.size()> layouts{};
+        for (size_t i = 0; i < layouts.size(); ++i)
+        {
+            layouts[i] = PARSED_LEVELS[i].layout;
+        }
+        return layouts;
+    }
+
+    // Only the packed layouts reach flash; the text is gone after compiling.
+    constexpr std::array<LevelLayout, PARSED_LEVELS.size()> LEVELS = MakeLayouts();
+}
+
+size_t GetLevelCount()
+{
+    return LEVELS.size();
+}
+
+const LevelLayout& GetLevelLayout(size_t index)
+{
+    return LEVELS[index];
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "BrickField.h"
+
+#include <cstddef>
+
+// Levels compiled into flash, played in order.
+size_t GetLevelCount();
+const LevelLayout& GetLevelLayout(size_t index);
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Fixed.h"
+
+#include <cmath>
+#include <cstdint>
+
+// Number type of the simulation. With ARKANOID_FIXED_POINT the physics runs
+// on Q16.16 integers and gives bit-identical results on host and target;
+// otherwise it uses the FPU.
+#ifdef ARKANOID_FIXED_POINT
+using Scalar = Fixed;
+#else
+using Scalar = float;
+#endif
+
+inline float ToFloat(float value) { return value; }
+inline float Abs(float value) { return std::fabs(value); }
+inline float Sqrt(float value) { return std::sqrt(value); }
+inline float Round(float value) { return std::round(value); }
+inline int Floor(float value) { return static_cast<int>(std::floor(value)); }
+inline int RoundToInt(float value) { return static_cast<int>(std::round(value)); }
+
+inline float ToFloat(Fixed value) { return value.ToFloat(); }
+inline Fixed Abs(Fixed value) { return value < Fixed() ? -value : value; }
+inline int Floor(Fixed value) { return value.Raw() >> Fixed::FRACTION_BITS; }
+inline int RoundToInt(Fixed value) { return (value.Raw() + Fixed::ONE / 2) >> Fixed::FRACTION_BITS; }
+inline Fixed Round(Fixed value) { return RoundToInt(value); }
+
+inline Fixed Sqrt(Fixed value)
+{
+    if (value.Raw() <= 0)
+    {
+        return Fixed();
+    }
+
+    // Integer square root of raw << 16, one result bit per iteration.
+    uint64_t remainder = static_cast<uint64_t>(value.Raw()) << Fixed::FRACTION_BITS;
+    uint64_t root = 0;
+    uint64_t bit = uint64_t(1) << 62;
+    while (bit > remainder)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (remainder >= root + bit)
+        {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return Fixed::FromRaw(static_cast<int32_t>(root));
+}
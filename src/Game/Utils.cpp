@@ -1,15 +1,127 @@
 #include "Utils.h"
 
 #include <algorithm>
+#include <limits>
+
+namespace
+{
+    bool RayEntersBox(Scalar px, Scalar py, Scalar dx, Scalar dy,
+                      Scalar minX, Scalar minY, Scalar maxX, Scalar maxY,
+                      Scalar& t, bool& xAxis)
+    {
+        Scalar tNear = std::numeric_limits<Scalar>::lowest();
+        Scalar tFar = std::numeric_limits<Scalar>::max();
+
+        if (dx == 0)
+        {
+            if (px < minX || px > maxX)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const Scalar t1 = (minX - px) / dx;
+            const Scalar t2 = (maxX - px) / dx;
+            tNear = std::min(t1, t2);
+            tFar = std::max(t1, t2);
+            xAxis = true;
+        }
+
+        if (dy == 0)
+        {
+            if (py < minY || py > maxY)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const Scalar t1 = (minY - py) / dy;
+            const Scalar t2 = (maxY - py) / dy;
+            if (std::min(t1, t2) > tNear)
+            {
+                tNear = std::min(t1, t2);
+                xAxis = false;
+            }
+            tFar = std::min(tFar, std::max(t1, t2));
+        }
+
+        if (tNear > tFar || tNear < 0 || tNear > 1)
+        {
+            return false;
+        }
+
+        t = tNear;
+        return true;
+    }
+
+    bool RayEntersCircle(Scalar px, Scalar py, Scalar dx, Scalar dy,
+                         Scalar cx, Scalar cy, Scalar r, Scalar& t)
+    {
+        // Solved along the unit direction rather than as a quadratic in t,
+        // which keeps every intermediate within the range of Q16.16.
+        const Scalar length = Sqrt(dx * dx + dy * dy);
+        if (length == 0)
+        {
+            return false;
+        }
+
+        const Scalar ux = dx / length;
+        const Scalar uy = dy / length;
+        const Scalar fx = cx - px;
+        const Scalar fy = cy - py;
+        const Scalar distanceSquared = fx * fx + fy * fy;
+        const Scalar r2 = r * r;
+
+        if (distanceSquared <= r2)
+        {
+            return false;
+        }
+
+        const Scalar along = fx * ux + fy * uy;
+        const Scalar offsetSquared = distanceSquared - along * along;
+        if (along <= 0 || offsetSquared > r2)
+        {
+            return false;
+        }
+
+        const Scalar hit = (along - Sqrt(r2 - offsetSquared)) / length;
+        if (hit < 0 || hit > 1)
+        {
+            return false;
+        }
+
+        t = hit;
+        return true;
+    }
+
+    bool MovesInto(CollisionSide side, Scalar dx, Scalar dy)
+    {
+        switch (side)
+        {
+            case CollisionSide::Left:
+                return dx > 0;
+            case CollisionSide::Right:
+                return dx < 0;
+            case CollisionSide::Bottom:
+                return dy > 0;
+            case CollisionSide::Top:
+                return dy < 0;
+            default:
+                return false;
+        }
+    }
+}
 
 CollisionSide GetCollisionSide(const Circle& circle, const Rect& rect)
 {
-    float nearestX = std::max(rect.x, std::min(circle.x, rect.x + rect.w));
-    float nearestY = std::max(rect.y, std::min(circle.y, rect.y + rect.h));
+    Scalar nearestX = std::max(rect.x, std::min(circle.x, rect.x + rect.w));
+    Scalar nearestY = std::max(rect.y, std::min(circle.y, rect.y + rect.h));
 
-    float deltaX = circle.x - nearestX;
-    float deltaY = circle.y - nearestY;
-    float distanceSquared = deltaX * deltaX + deltaY * deltaY;
+    Scalar deltaX = circle.x - nearestX;
+    Scalar deltaY = circle.y - nearestY;
+    Scalar distanceSquared = deltaX * deltaX + deltaY * deltaY;
 
     if (distanceSquared >= (circle.r * circle.r))
     {
@@ -17,10 +129,10 @@ CollisionSide GetCollisionSide(const Circle& circle, const Rect& rect)
     }
 
     // Determine if nearest point is on an edge or corner
-    float leftEdge = rect.x;
-    float rightEdge = rect.x + rect.w;
-    float bottomEdge = rect.y;
-    float topEdge = rect.y + rect.h;
+    Scalar leftEdge = rect.x;
+    Scalar rightEdge = rect.x + rect.w;
+    Scalar bottomEdge = rect.y;
+    Scalar topEdge = rect.y + rect.h;
 
     const bool isOnLeftEdge = (nearestX == leftEdge);
     const bool isOnRightEdge = (nearestX == rightEdge);
@@ -31,12 +143,12 @@ CollisionSide GetCollisionSide(const Circle& circle, const Rect& rect)
 
     if (isCornerCollision)
     {
-        float penetrationLeft = (circle.x + circle.r) - leftEdge;
-        float penetrationRight = rightEdge - (circle.x - circle.r);
-        float penetrationBottom = (circle.y + circle.r) - bottomEdge;
-        float penetrationTop = topEdge - (circle.y - circle.r);
+        Scalar penetrationLeft = (circle.x + circle.r) - leftEdge;
+        Scalar penetrationRight = rightEdge - (circle.x - circle.r);
+        Scalar penetrationBottom = (circle.y + circle.r) - bottomEdge;
+        Scalar penetrationTop = topEdge - (circle.y - circle.r);
 
-        float minPenetration = penetrationLeft;
+        Scalar minPenetration = penetrationLeft;
         CollisionSide side = CollisionSide::Left;
 
         if (isOnRightEdge && penetrationRight < minPenetration)
@@ -75,12 +187,139 @@ bool Intersects(const Circle& circle, const Rect& rect)
     return GetCollisionSide(circle, rect) != CollisionSide::None;
 }
 
-bool IntersectsVerticalWall(const Circle& circle, float x)
+bool IntersectsVerticalWall(const Circle& circle, Scalar x)
+{
+    return Abs(circle.x - x) < circle.r;
+}
+
+bool IntersectsHorizontalWall(const Circle& circle, Scalar y)
+{
+    return Abs(circle.y - y) < circle.r;
+}
+
+bool SweepCircleRect(const Circle& circle, Scalar dx, Scalar dy, const Rect& rect,
+                     Scalar& toi, CollisionSide& side)
 {
-    return std::abs(circle.x - x) < circle.r;
+    const CollisionSide overlap = GetCollisionSide(circle, rect);
+    if (overlap != CollisionSide::None)
+    {
+        if (!MovesInto(overlap, dx, dy))
+        {
+            return false;
+        }
+
+        toi = 0;
+        side = overlap;
+        return true;
+    }
+
+    // Nothing along the path comes within reach of the rect.
+    if (std::min(circle.x, circle.x + dx) - circle.r > rect.x + rect.w
+        || std::max(circle.x, circle.x + dx) + circle.r < rect.x
+        || std::min(circle.y, circle.y + dy) - circle.r > rect.y + rect.h
+        || std::max(circle.y, circle.y + dy) + circle.r < rect.y)
+    {
+        return false;
+    }
+
+    // The rect grown by the radius with rounded corners: two slabs for the
+    // faces and a circle at every corner. Keep the earliest entry.
+    const Scalar left = rect.x;
+    const Scalar right = rect.x + rect.w;
+    const Scalar bottom = rect.y;
+    const Scalar top = rect.y + rect.h;
+    const Scalar r = circle.r;
+
+    bool hit = false;
+    Scalar t = 0;
+    bool xAxis = false;
+
+    if (RayEntersBox(circle.x, circle.y, dx, dy, left - r, bottom, right + r, top, t, xAxis))
+    {
+        hit = true;
+        toi = t;
+        side = xAxis ? (dx > 0 ? CollisionSide::Left : CollisionSide::Right)
+                     : (dy > 0 ? CollisionSide::Bottom : CollisionSide::Top);
+    }
+
+    if (RayEntersBox(circle.x, circle.y, dx, dy, left, bottom - r, right, top + r, t, xAxis)
+        && (!hit || t < toi))
+    {
+        hit = true;
+        toi = t;
+        side = xAxis ? (dx > 0 ? CollisionSide::Left : CollisionSide::Right)
+                     : (dy > 0 ? CollisionSide::Bottom : CollisionSide::Top);
+    }
+
+    const Scalar cornersX[] = {left, right, left, right};
+    const Scalar cornersY[] = {bottom, bottom, top, top};
+    for (int i = 0; i < 4; ++i)
+    {
+        if (RayEntersCircle(circle.x, circle.y, dx, dy, cornersX[i], cornersY[i], r, t)
+            && (!hit || t < toi))
+        {
+            hit = true;
+            toi = t;
+
+            const Scalar nx = circle.x + dx * t - cornersX[i];
+            const Scalar ny = circle.y + dy * t - cornersY[i];
+            if (Abs(nx) > Abs(ny))
+            {
+                side = nx < 0 ? CollisionSide::Left : CollisionSide::Right;
+            }
+            else
+            {
+                side = ny < 0 ? CollisionSide::Bottom : CollisionSide::Top;
+            }
+        }
+    }
+
+    return hit;
+}
+
+bool SweepCircleVerticalWall(const Circle& circle, Scalar dx, Scalar x, Scalar& toi)
+{
+    if (dx == 0)
+    {
+        return false;
+    }
+
+    // Touching plane on the side the circle comes from.
+    const Scalar contact = circle.x < x ? x - circle.r : x + circle.r;
+    if ((dx > 0) != (circle.x < x))
+    {
+        return false;
+    }
+
+    const Scalar t = std::max<Scalar>(0, (contact - circle.x) / dx);
+    if (t > 1)
+    {
+        return false;
+    }
+
+    toi = t;
+    return true;
 }
 
-bool IntersectsHorizontalWall(const Circle& circle, float y)
+bool SweepCircleHorizontalWall(const Circle& circle, Scalar dy, Scalar y, Scalar& toi)
 {
-    return std::abs(circle.y - y) < circle.r;
+    if (dy == 0)
+    {
+        return false;
+    }
+
+    const Scalar contact = circle.y < y ? y - circle.r : y + circle.r;
+    if ((dy > 0) != (circle.y < y))
+    {
+        return false;
+    }
+
+    const Scalar t = std::max<Scalar>(0, (contact - circle.y) / dy);
+    if (t > 1)
+    {
+        return false;
+    }
+
+    toi = t;
+    return true;
 }
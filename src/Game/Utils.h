@@ -1,26 +1,30 @@
+#pragma once
+
+#include "Scalar.h"
+
 #define PI 3.14159265358979323846
 
 struct Rect
 {
-    float x;
-    float y;
-    float w;
-    float h;
+    Scalar x;
+    Scalar y;
+    Scalar w;
+    Scalar h;
 };
 
 struct Circle
 {
-    float x;
-    float y;
-    float r;
+    Scalar x;
+    Scalar y;
+    Scalar r;
 };
 
 struct Line
 {
-    float x1;
-    float y1;
-    float x2;
-    float y2;
+    Scalar x1;
+    Scalar y1;
+    Scalar x2;
+    Scalar y2;
 };
 
 enum class CollisionSide
@@ -35,8 +39,30 @@ enum class CollisionSide
 bool Intersects(const Circle& circle, const Rect& rect);
 CollisionSide GetCollisionSide(const Circle& circle, const Rect& rect);
 
-bool IntersectsVerticalWall(const Circle& circle, float x);
-bool IntersectsHorizontalWall(const Circle& circle, float y);
+bool IntersectsVerticalWall(const Circle& circle, Scalar x);
+bool IntersectsHorizontalWall(const Circle& circle, Scalar y);
+
+// Swept tests for a circle moving by (dx, dy) during one step. On a hit,
+// toi is the fraction of the step at which the circle first touches the
+// rect, and side is the face it touches, as in GetCollisionSide. A circle
+// that already overlaps the rect hits at toi 0 only if it moves inwards.
+bool SweepCircleRect(const Circle& circle, Scalar dx, Scalar dy, const Rect& rect,
+                     Scalar& toi, CollisionSide& side);
+bool SweepCircleVerticalWall(const Circle& circle, Scalar dx, Scalar x, Scalar& toi);
+bool SweepCircleHorizontalWall(const Circle& circle, Scalar dy, Scalar y, Scalar& toi);
+
+// Index of the lowest set bit; bits must not be 0. Compiles to RBIT + CLZ
+// on Cortex-M4.
+inline int LowestBit(uint32_t bits)
+{
+    return __builtin_ctz(bits);
+}
+
+// Index of the highest set bit; bits must not be 0. A single CLZ.
+inline int HighestBit(uint32_t bits)
+{
+    return 31 - __builtin_clz(bits);
+}
 
 template<typename T>
 inline T Lerp(T a, T b, float t)
@@ -0,0 +1,65 @@
+#include "Input.h"
+
+#ifdef STM32F446xx
+#include "FrameTimer/FrameTimer.h"
+
+extern "C"
+{
+#include "stm32f4xx_hal.h"
+}
+#endif
+
+SpscQueue<InputEvent, Input::QUEUE_SIZE> Input::_queue;
+uint32_t Input::_ticksPerSecond = 1;
+uint32_t Input::_debounceTicks = 0;
+std::array<uint32_t, static_cast<size_t>(Button::Count)> Input::_lastEdge{};
+std::array<bool, static_cast<size_t>(Button::Count)> Input::_pressed{};
+
+void Input::Init(uint32_t ticksPerSecond)
+{
+    _ticksPerSecond = ticksPerSecond;
+    _debounceTicks = ticksPerSecond / 1000 * DEBOUNCE_MS;
+}
+
+void Input::OnEdge(Button button, bool pressed, uint32_t time)
+{
+    const size_t index = static_cast<size_t>(button);
+    if (pressed == _pressed[index] || time - _lastEdge[index] < _debounceTicks)
+    {
+        return;
+    }
+
+    // A full queue keeps the old state, so the edge is retried on the next
+    // bounce or release instead of leaving the button stuck.
+    if (_queue.Push({time, button, pressed}))
+    {
+        _pressed[index] = pressed;
+        _lastEdge[index] = time;
+    }
+}
+
+#ifdef STM32F446xx
+void Input::PollPins()
+{
+    const uint32_t time = FrameTimer::Now();
+    OnEdge(Button::Left, HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_2) == GPIO_PIN_SET, time);
+    OnEdge(Button::Right, HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_3) == GPIO_PIN_SET, time);
+}
+
+extern "C" void HAL_GPIO_EXTI_Callback(uint16_t pin)
+{
+    const uint32_t time = FrameTimer::Now();
+
+    switch (pin)
+    {
+        case GPIO_PIN_2:
+            Input::OnEdge(Button::Left, HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_2) == GPIO_PIN_SET, time);
+            break;
+        case GPIO_PIN_3:
+            Input::OnEdge(Button::Right, HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_3) == GPIO_PIN_SET, time);
+            break;
+        default:
+            break;
+    }
+}
+#endif
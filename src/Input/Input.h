@@ -0,0 +1,54 @@
+#pragma once
+
+#include "SpscQueue.h"
+
+#include <array>
+#include <cstdint>
+
+enum class Button : uint8_t
+{
+    Left,
+    Right,
+    Count
+};
+
+struct InputEvent
+{
+    uint32_t time;
+    Button button;
+    bool pressed;
+};
+
+// Button edges captured by the EXTI interrupts. Times are ticks of the
+// frame timer on target; the queue stays empty on the host.
+class Input
+{
+public:
+    static constexpr size_t QUEUE_SIZE = 32;
+    static constexpr uint32_t DEBOUNCE_MS = 5;
+
+    static void Init(uint32_t ticksPerSecond);
+    static uint32_t TicksPerSecond() { return _ticksPerSecond; }
+
+    // Producer side, called from the interrupt handler with the pin level.
+    // Bounces within DEBOUNCE_MS of the last accepted edge and repeated
+    // levels are dropped.
+    static void OnEdge(Button button, bool pressed, uint32_t time);
+    // Target only: feeds the current pin levels through OnEdge. An edge
+    // dropped inside the debounce window, such as the release of a short
+    // tap, is queued once the window has passed instead of leaving the
+    // button in the wrong state. Runs from the frame tick, whose interrupt
+    // priority matches EXTI, so the queue keeps a single producer.
+    static void PollPins();
+
+    // Consumer side.
+    static bool Peek(InputEvent& event) { return _queue.Peek(event); }
+    static void Pop() { _queue.Pop(); }
+
+private:
+    static SpscQueue<InputEvent, QUEUE_SIZE> _queue;
+    static uint32_t _ticksPerSecond;
+    static uint32_t _debounceTicks;
+    static std::array<uint32_t, static_cast<size_t>(Button::Count)> _lastEdge;
+    static std::array<bool, static_cast<size_t>(Button::Count)> _pressed;
+};
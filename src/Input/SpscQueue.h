@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Lock-free ring for exactly one producer (e.g. an interrupt handler) and
+// one consumer (the main loop). N must be a power of two; one slot stays
+// free to tell a full queue from an empty one.
+template<typename T, size_t N>
+class SpscQueue
+{
+public:
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+    bool Push(const T& value)
+    {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        const size_t next = (head + 1) & (N - 1);
+        if (next == _tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        _items[head] = value;
+        _head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool Peek(T& value) const
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        value = _items[tail];
+        return true;
+    }
+
+    void Pop()
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail != _head.load(std::memory_order_acquire))
+        {
+            _tail.store((tail + 1) & (N - 1), std::memory_order_release);
+        }
+    }
+
+    bool empty() const
+    {
+        return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<T, N> _items{};
+    std::atomic<size_t> _head{0};
+    std::atomic<size_t> _tail{0};
+};
@@ -0,0 +1,137 @@
+#include "Profiler.h"
+
+#include <algorithm>
+
+#ifdef STM32F446xx
+extern "C"
+{
+#include "stm32f4xx.h"
+}
+#else
+#include <chrono>
+#include <cstdio>
+#endif
+
+namespace
+{
+    constexpr const char* ZONE_NAMES[] = {
+        "Update",
+        "UpdateCollisions",
+        "DrawObject",
+        "UpdateScreen"
+    };
+
+    static_assert(sizeof(ZONE_NAMES) / sizeof(ZONE_NAMES[0]) == static_cast<size_t>(ProfileZone::Count));
+
+#ifdef STM32F446xx
+    void Emit(const char* text)
+    {
+        while (*text)
+        {
+            ITM_SendChar(*text++);
+        }
+    }
+
+    void Emit(uint32_t value)
+    {
+        char digits[10];
+        int count = 0;
+        do
+        {
+            digits[count++] = '0' + value % 10;
+            value /= 10;
+        } while (value != 0);
+
+        while (count > 0)
+        {
+            ITM_SendChar(digits[--count]);
+        }
+    }
+#endif
+}
+
+std::array<Profiler::Ring, static_cast<size_t>(ProfileZone::Count)> Profiler::_rings;
+
+uint32_t Profiler::Now()
+{
+#ifdef STM32F446xx
+    return DWT->CYCCNT;
+#else
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+#endif
+}
+
+const char* Profiler::TickUnit()
+{
+#ifdef STM32F446xx
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+void Profiler::Record(ProfileZone zone, uint32_t ticks)
+{
+    Ring& ring = _rings[static_cast<size_t>(zone)];
+    ring.ticks[ring.next] = ticks;
+    ring.next = (ring.next + 1) % RING_SIZE;
+    ring.size = std::min<uint8_t>(ring.size + 1, RING_SIZE);
+}
+
+ZoneStats Profiler::GetStats(ProfileZone zone)
+{
+    const Ring& ring = _rings[static_cast<size_t>(zone)];
+    ZoneStats stats;
+    if (ring.size == 0)
+    {
+        return stats;
+    }
+
+    uint64_t total = 0;
+    stats.min = ring.ticks[0];
+    for (uint8_t i = 0; i < ring.size; ++i)
+    {
+        stats.min = std::min(stats.min, ring.ticks[i]);
+        stats.max = std::max(stats.max, ring.ticks[i]);
+        total += ring.ticks[i];
+    }
+
+    stats.avg = static_cast<uint32_t>(total / ring.size);
+    stats.samples = ring.size;
+    return stats;
+}
+
+void Profiler::Reset()
+{
+    _rings = {};
+}
+
+void Profiler::Report()
+{
+    for (size_t i = 0; i < static_cast<size_t>(ProfileZone::Count); ++i)
+    {
+        const ZoneStats stats = GetStats(static_cast<ProfileZone>(i));
+        if (stats.samples == 0)
+        {
+            continue;
+        }
+
+#ifdef STM32F446xx
+        Emit(ZONE_NAMES[i]);
+        Emit(" min ");
+        Emit(stats.min);
+        Emit(" avg ");
+        Emit(stats.avg);
+        Emit(" max ");
+        Emit(stats.max);
+        Emit(" ");
+        Emit(TickUnit());
+        Emit("\n");
+#else
+        std::printf("%-18s min %8u avg %8u max %8u %s\n", ZONE_NAMES[i],
+                    static_cast<unsigned>(stats.min), static_cast<unsigned>(stats.avg),
+                    static_cast<unsigned>(stats.max), TickUnit());
+#endif
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Scoped timing zones. On target the ticks are DWT cycles, on the host they
+// are nanoseconds from std::chrono. Zones compile to nothing unless the
+// build defines ARKANOID_PROFILE.
+
+enum class ProfileZone : uint8_t
+{
+    Update,
+    UpdateCollisions,
+    DrawObject,
+    UpdateScreen,
+    Count
+};
+
+struct ZoneStats
+{
+    uint32_t min = 0;
+    uint32_t max = 0;
+    uint32_t avg = 0;
+    uint32_t samples = 0;
+};
+
+class Profiler
+{
+public:
+    static constexpr uint8_t RING_SIZE = 64;
+
+    static uint32_t Now();
+    static const char* TickUnit();
+
+    static void Record(ProfileZone zone, uint32_t ticks);
+    static ZoneStats GetStats(ProfileZone zone);
+    static void Reset();
+
+    // Emits min/avg/max of every zone over ITM stimulus port 0 on target,
+    // stdout on the host.
+    static void Report();
+
+private:
+    struct Ring
+    {
+        std::array<uint32_t, RING_SIZE> ticks{};
+        uint8_t next = 0;
+        uint8_t size = 0;
+    };
+
+    static std::array<Ring, static_cast<size_t>(ProfileZone::Count)> _rings;
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(ProfileZone zone) : _zone(zone), _start(Profiler::Now()) {}
+    ~ProfileScope() { Profiler::Record(_zone, Profiler::Now() - _start); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileZone _zone;
+    uint32_t _start;
+};
+
+#ifdef ARKANOID_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(zone) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(ProfileZone::zone)
+#else
+#define PROFILE_ZONE(zone) ((void)0)
+#endif
@@ -3,56 +3,92 @@ extern "C"
 #include "main.h"
 #include "stm32f4xx_hal.h"
 #include "gpio.h"
+#include "dma.h"
 #include "i2c.h"
 }
 
 #include "ssd1306/Display.h"
+#include "ssd1306/HalI2CLink.h"
+#include "FrameTimer/FrameTimer.h"
 #include "Game/Game.h"
+#include "Input/Input.h"
+#include "Profiler/Profiler.h"
 
-#include <vector>
+#include <algorithm>
+
+#ifndef ARKANOID_FRAME_RATE
+#define ARKANOID_FRAME_RATE 60
+#endif
 
 int main()
 {
     HAL_Init();
     SystemClock_Config();
     MX_GPIO_Init();
+    MX_DMA_Init();
     MX_I2C1_Init();
 
     CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
     DWT->CYCCNT = 0;
     DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 
+    HalI2CLink link(&hi2c1);
     Display display;
-    display.Init(&hi2c1);
+    display.Init(&link);
+    display.SetFrameDiff(true);
+
+    FrameTimer::Start(ARKANOID_FRAME_RATE);
+    Input::Init(FrameTimer::TICKS_PER_SECOND);
+    FrameTimer::SetFrameCallback(&Input::PollPins);
 
     Game game;
     game.Init();
+    game.SetRenderMode(RenderMode::PageCompose);
 
-    uint32_t lastTick  = DWT->CYCCNT;
+    // The accumulator counts in 1 / (TICKS_PER_SECOND * STEP_RATE) seconds,
+    // so a step is exactly TICKS_PER_SECOND units.
+    constexpr uint32_t step = FrameTimer::TICKS_PER_SECOND;
+    constexpr uint32_t maxElapsed = Game::MAX_CATCH_UP_STEPS * step / Game::STEP_RATE + 1;
+    uint32_t lastTick = FrameTimer::Now();
+    uint32_t accumulator = 0;
+#ifdef ARKANOID_PROFILE
+    uint32_t framesSinceReport = 0;
+#endif
 
     while (true)
     {
-        uint32_t dtCycles = DWT->CYCCNT - lastTick;
-        lastTick += dtCycles;
-        float dt = static_cast<float>(dtCycles) / static_cast<float>(SystemCoreClock);
+        const uint32_t now = FrameTimer::Now();
+        const uint32_t elapsed = std::min(now - lastTick, maxElapsed);
+        lastTick = now;
 
-        if (dt < 1.f / 60.f)
+        // Physics runs in fixed steps regardless of how long the flush took;
+        // time beyond the catch-up limit is dropped.
+        accumulator = std::min(accumulator + elapsed * Game::STEP_RATE, Game::MAX_CATCH_UP_STEPS * step);
+
+        // Button edges are timestamped with the same clock, so each step
+        // takes the ones that happened up to its end.
+        while (accumulator >= step)
         {
-            HAL_Delay(static_cast<uint32_t>((1.f / 60.f - dt) * 1000.f));
-            dt = 1.f / 60.f;
+            accumulator -= step;
+            game.Update(Game::STEP_DT, now - accumulator / Game::STEP_RATE);
         }
 
-        game.Update(dt);
-        if (HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_2))
+        // A frame the link has not finished sending yet is skipped rather
+        // than waited for.
+        if (!display.IsBusy())
         {
-            game.OnLeftPressed();
+            game.Draw(display, static_cast<float>(accumulator) / static_cast<float>(step));
         }
-        if (HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_3))
+
+#ifdef ARKANOID_PROFILE
+        if (++framesSinceReport == 120)
         {
-            game.OnRightPressed();
+            framesSinceReport = 0;
+            Profiler::Report();
         }
+#endif
 
-        game.Draw(display);
+        FrameTimer::WaitForFrame();
     }
 
     return 0;
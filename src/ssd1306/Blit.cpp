@@ -0,0 +1,106 @@
+#include "Blit.h"
+
+#include "Display.h"
+
+#include <algorithm>
+
+namespace Blit
+{
+    uint8_t PageMask(int page, int y, int height)
+    {
+        const int low = std::max(0, y - page * 8);
+        const int high = std::min(8, y + height - page * 8);
+        if (low >= high)
+        {
+            return 0;
+        }
+
+        return static_cast<uint8_t>((0xFFu << low) & (0xFFu >> (8 - high)));
+    }
+
+    ColumnSpan FillRect(uint8_t* row, int page, int x, int y, int w, int h, bool color)
+    {
+        ColumnSpan changed;
+        const uint8_t mask = PageMask(page, y, h);
+        const int xStart = std::max(x, 0);
+        const int xEnd = std::min(x + w, static_cast<int>(DISPLAY_WIDTH));
+        if (mask == 0)
+        {
+            return changed;
+        }
+
+        for (int column = xStart; column < xEnd; ++column)
+        {
+            const uint8_t value = color ? (row[column] | mask) : (row[column] & ~mask);
+            if (value != row[column])
+            {
+                row[column] = value;
+                changed.start = changed.empty() ? column : changed.start;
+                changed.end = column + 1;
+            }
+        }
+
+        return changed;
+    }
+
+    ColumnSpan DrawSprite(uint8_t* row, int page, int x, int y, const Sprite& sprite, BlitMode mode)
+    {
+        ColumnSpan changed;
+        const int basePage = (y >= 0 ? y : y - 7) / 8;
+        const uint8_t shift = y - basePage * 8;
+        const int i = page - basePage;
+        const uint8_t mask = PageMask(i, shift, sprite.height);
+        const int xStart = std::max(x, 0);
+        const int xEnd = std::min(x + sprite.width, static_cast<int>(DISPLAY_WIDTH));
+        if (mask == 0)
+        {
+            return changed;
+        }
+
+        // A pre-shifted variant if the atlas has one, otherwise each byte is
+        // combined from two pages of the source.
+        const uint8_t* source = shift == 0 ? sprite.data
+                              : sprite.shifted ? sprite.Shifted(shift)
+                              : nullptr;
+
+        for (int column = xStart; column < xEnd; ++column)
+        {
+            const int sx = column - x;
+            uint8_t bits;
+            if (source)
+            {
+                bits = source[i * sprite.width + sx];
+            }
+            else
+            {
+                const uint8_t high = i < sprite.pages ? sprite.data[i * sprite.width + sx] : 0;
+                const uint8_t low = i > 0 ? sprite.data[(i - 1) * sprite.width + sx] : 0;
+                bits = static_cast<uint8_t>((high << shift) | (low >> (8 - shift)));
+            }
+            bits &= mask;
+
+            uint8_t value;
+            switch (mode)
+            {
+                case BlitMode::Set:
+                    value = row[column] | bits;
+                    break;
+                case BlitMode::Clear:
+                    value = row[column] & ~bits;
+                    break;
+                default:
+                    value = (row[column] & ~mask) | bits;
+                    break;
+            }
+
+            if (value != row[column])
+            {
+                row[column] = value;
+                changed.start = changed.empty() ? column : changed.start;
+                changed.end = column + 1;
+            }
+        }
+
+        return changed;
+    }
+}
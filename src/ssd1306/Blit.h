@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Sprite.h"
+
+#include <cstdint>
+
+enum class BlitMode
+{
+    Copy,   // replace everything under the sprite's rectangle
+    Set,    // light the sprite's lit pixels
+    Clear   // turn the sprite's lit pixels off
+};
+
+// Column range [start, end) of the bytes a page blit changed.
+struct ColumnSpan
+{
+    int start = 0;
+    int end = 0;
+
+    bool empty() const { return start >= end; }
+};
+
+// Byte-wise drawing into one page row (DISPLAY_WIDTH bytes) of a frame
+// buffer or scratch line. Coordinates are screen pixels; whatever falls
+// outside the page or the screen width is clipped.
+namespace Blit
+{
+    // Bits of the page covered by rows [y, y + height).
+    uint8_t PageMask(int page, int y, int height);
+
+    ColumnSpan FillRect(uint8_t* row, int page, int x, int y, int w, int h, bool color);
+    ColumnSpan DrawSprite(uint8_t* row, int page, int x, int y, const Sprite& sprite, BlitMode mode);
+}
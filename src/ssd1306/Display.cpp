@@ -0,0 +1,444 @@
+#include "Display.h"
+
+#include "Profiler/Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // Horizontal addressing mode, page 0 at the bottom of the panel so that
+    // y grows upwards like in the game field.
+    constexpr uint8_t INIT_SEQUENCE[] = {
+        0xAE,       // display off
+        0xD5, 0x80, // clock divide ratio
+        0xA8, 0x3F, // multiplex ratio 64
+        0xD3, 0x00, // display offset
+        0x40,       // start line 0
+        0x8D, 0x14, // charge pump on
+        0x20, 0x00, // horizontal addressing mode
+        0xA1,       // segment remap
+        0xC0,       // COM scan from COM0
+        0xDA, 0x12, // COM pins configuration
+        0x81, 0xCF, // contrast
+        0xD9, 0xF1, // pre-charge period
+        0xDB, 0x40, // VCOMH deselect level
+        0xA4,       // display follows RAM
+        0xA6,       // normal, not inverted
+        0xAF        // display on
+    };
+
+    constexpr uint8_t SET_COLUMN_ADDRESS = 0x21;
+    constexpr uint8_t SET_PAGE_ADDRESS = 0x22;
+
+    // Every extra span costs an address window transaction (~8 bytes on the
+    // wire), so unchanged gaps shorter than that are sent along.
+    constexpr int SPAN_MERGE_GAP = 8;
+}
+
+void Display::Init(I2CLink* link)
+{
+    _link = link;
+    _link->SetCompletionHandler(&Display::OnTransferComplete, this);
+    SendCommands(INIT_SEQUENCE, sizeof(INIT_SEQUENCE));
+
+    // The panel RAM content is unknown after reset, so the first frame is
+    // sent in full.
+    const bool frameDiff = _frameDiff;
+    _frameDiff = false;
+    FillBlack();
+    _flushMode = FlushMode::Blocking;
+    UpdateScreen();
+    _flushMode = FlushMode::Async;
+    _frameDiff = frameDiff;
+}
+
+void Display::FillBlack()
+{
+    Back().fill(0);
+    MarkAllDirty();
+}
+
+void Display::MarkDirty(int page, int start, int end)
+{
+    if (_dirtyStart[page] >= _dirtyEnd[page])
+    {
+        _dirtyStart[page] = start;
+        _dirtyEnd[page] = end;
+        return;
+    }
+
+    _dirtyStart[page] = std::min<int>(_dirtyStart[page], start);
+    _dirtyEnd[page] = std::max<int>(_dirtyEnd[page], end);
+}
+
+void Display::MarkAllDirty()
+{
+    _dirtyStart.fill(0);
+    _dirtyEnd.fill(DISPLAY_WIDTH);
+}
+
+void Display::SetPixel(int x, int y, bool color)
+{
+    if (x < 0 || x >= DISPLAY_WIDTH || y < 0 || y >= DISPLAY_HEIGHT)
+    {
+        return;
+    }
+
+    const int page = y / 8;
+    uint8_t& byte = Back()[page * DISPLAY_WIDTH + x];
+    const uint8_t mask = 1u << (y % 8);
+    const uint8_t value = color ? (byte | mask) : (byte & ~mask);
+
+    if (value != byte)
+    {
+        byte = value;
+        MarkDirty(page, x, x + 1);
+    }
+}
+
+void Display::DrawPixel(uint8_t x, uint8_t y, bool color)
+{
+    SetPixel(x, y, color);
+}
+
+void Display::DrawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool color)
+{
+    const int yEnd = std::min<int>(y + h, DISPLAY_HEIGHT);
+    for (int page = y / 8; page * 8 < yEnd; ++page)
+    {
+        const ColumnSpan changed = Blit::FillRect(&Back()[page * DISPLAY_WIDTH], page, x, y, w, yEnd - y, color);
+        if (!changed.empty())
+        {
+            MarkDirty(page, changed.start, changed.end);
+        }
+    }
+}
+
+void Display::DrawCircle(uint8_t x, uint8_t y, uint8_t radius, bool color, bool fill)
+{
+    const int r = radius;
+    const int r2 = r * r;
+
+    for (int dy = -r; dy <= r; ++dy)
+    {
+        for (int dx = -r; dx <= r; ++dx)
+        {
+            const int d2 = dx * dx + dy * dy;
+            const bool inside = d2 <= r2 + r;
+            const bool onEdge = inside && d2 > r2 - r;
+            if (fill ? inside : onEdge)
+            {
+                SetPixel(x + dx, y + dy, color);
+            }
+        }
+    }
+}
+
+void Display::DrawImage(uint8_t x, uint8_t page, const uint8_t* image, size_t size, uint8_t pages)
+{
+    if (pages == 0 || x >= DISPLAY_WIDTH)
+    {
+        return;
+    }
+
+    const size_t width = size / pages;
+    const size_t visibleWidth = std::min<size_t>(width, DISPLAY_WIDTH - x);
+
+    for (uint8_t p = 0; p < pages && page + p < DISPLAY_PAGES; ++p)
+    {
+        std::memcpy(&Back()[(page + p) * DISPLAY_WIDTH + x], image + p * width, visibleWidth);
+        MarkDirty(page + p, x, x + visibleWidth);
+    }
+}
+
+void Display::DrawImage(const std::array<uint8_t, DISPLAY_BUFFER_SIZE>& image)
+{
+    Back() = image;
+    MarkAllDirty();
+}
+
+void Display::DrawImage(const CompressedImage& image)
+{
+    Buffer& back = Back();
+    const uint8_t* in = image.data;
+    const uint8_t* end = image.data + image.size;
+    size_t position = 0;
+
+    while (in < end && position < DISPLAY_BUFFER_SIZE)
+    {
+        const uint8_t value = *in++;
+        size_t count = 1;
+        if (value == 0 && in < end)
+        {
+            count = *in++;
+        }
+
+        for (; count > 0 && position < DISPLAY_BUFFER_SIZE; --count, ++position)
+        {
+            if (back[position] != value)
+            {
+                back[position] = value;
+                const int column = position % DISPLAY_WIDTH;
+                MarkDirty(position / DISPLAY_WIDTH, column, column + 1);
+            }
+        }
+    }
+}
+
+void Display::DrawSprite(int x, int y, const Sprite& sprite, BlitMode mode)
+{
+    const int firstPage = std::max(0, (y >= 0 ? y : y - 7) / 8);
+    const int lastPage = std::min(DISPLAY_PAGES - 1, (y + sprite.height - 1) / 8);
+
+    for (int page = firstPage; page <= lastPage; ++page)
+    {
+        const ColumnSpan changed = Blit::DrawSprite(&Back()[page * DISPLAY_WIDTH], page, x, y, sprite, mode);
+        if (!changed.empty())
+        {
+            MarkDirty(page, changed.start, changed.end);
+        }
+    }
+}
+
+void Display::WritePage(uint8_t page, const uint8_t* line)
+{
+    uint8_t* row = &Back()[page * DISPLAY_WIDTH];
+    int first = -1;
+    int last = -1;
+
+    for (int column = 0; column < DISPLAY_WIDTH; ++column)
+    {
+        if (row[column] != line[column])
+        {
+            row[column] = line[column];
+            first = first < 0 ? column : first;
+            last = column;
+        }
+    }
+
+    if (first >= 0)
+    {
+        MarkDirty(page, first, last + 1);
+    }
+}
+
+void Display::UpdateScreen()
+{
+    PROFILE_ZONE(UpdateScreen);
+
+    SwapBuffers();
+    if (_spanCount == 0)
+    {
+        return;
+    }
+
+    if (_flushMode == FlushMode::Async)
+    {
+        _flushing = true;
+        _nextTransfer = 0;
+        StartNextTransfer();
+        return;
+    }
+
+    const Buffer& front = Front();
+    for (uint8_t i = 0; i < _spanCount; ++i)
+    {
+        const Span& span = _spans[i];
+        const bool sent =
+            _link->Write(SSD1306_CONTROL_COMMAND, span.window.data(), span.window.size())
+            && _link->Write(SSD1306_CONTROL_DATA, &front[span.page * DISPLAY_WIDTH + span.start],
+                            span.end - span.start);
+        if (!sent)
+        {
+            _resendFrame = true;
+            return;
+        }
+    }
+}
+
+void Display::SwapBuffers()
+{
+    // The old front buffer is still being read by the DMA until the
+    // transfer completes.
+    WaitForFlush();
+
+    // After a failed transfer the front buffer is not what the panel shows,
+    // so neither the dirty spans nor a diff against it can be trusted.
+    const bool resend = _resendFrame;
+    if (resend)
+    {
+        _resendFrame = false;
+        MarkAllDirty();
+    }
+
+    // Turn the dirty spans of the new frame into the transfer list. In frame
+    // diff mode the front buffer still holds what the panel shows, so the
+    // spans are narrowed down to the bytes that differ from it.
+    _spanCount = 0;
+    for (uint8_t page = 0; page < DISPLAY_PAGES; ++page)
+    {
+        const uint8_t start = _dirtyStart[page];
+        const uint8_t end = _dirtyEnd[page];
+        if (start >= end)
+        {
+            continue;
+        }
+
+        if (_frameDiff && !resend)
+        {
+            AddChangedRuns(page, start, end);
+        }
+        else
+        {
+            AddSpan(page, start, end);
+        }
+    }
+
+    _dirtyStart.fill(0);
+    _dirtyEnd.fill(0);
+    _back ^= 1u;
+
+    // The new back buffer lags exactly by these spans, so copying them is
+    // enough to let game objects keep erasing and redrawing incrementally.
+    const Buffer& front = Front();
+    Buffer& back = Back();
+    for (uint8_t i = 0; i < _spanCount; ++i)
+    {
+        const Span& span = _spans[i];
+        const size_t offset = span.page * DISPLAY_WIDTH + span.start;
+        std::memcpy(&back[offset], &front[offset], span.end - span.start);
+    }
+}
+
+void Display::AddSpan(uint8_t page, uint8_t start, uint8_t end)
+{
+    // Spans are added page by page; once a page runs out of slots its last
+    // span absorbs the rest of the changes.
+    uint8_t pageSpans = 0;
+    while (pageSpans < _spanCount && _spans[_spanCount - 1 - pageSpans].page == page)
+    {
+        ++pageSpans;
+    }
+
+    if (pageSpans == MAX_SPANS_PER_PAGE)
+    {
+        Span& last = _spans[_spanCount - 1];
+        last.end = end;
+        last.window[2] = end - 1;
+        return;
+    }
+
+    Span& span = _spans[_spanCount++];
+    span.page = page;
+    span.start = start;
+    span.end = end;
+    span.window = {SET_COLUMN_ADDRESS, start, static_cast<uint8_t>(end - 1),
+                   SET_PAGE_ADDRESS, page, page};
+}
+
+void Display::AddChangedRuns(uint8_t page, uint8_t start, uint8_t end)
+{
+    const uint8_t* next = &Back()[page * DISPLAY_WIDTH];
+    const uint8_t* shown = &Front()[page * DISPLAY_WIDTH];
+
+    int runStart = -1;
+    int runEnd = -1;
+
+    // Pages are word aligned, so compare 32 bits at a time and locate the
+    // first/last differing byte of a word from the XOR (little endian).
+    for (int x = start & ~3; x < end; x += 4)
+    {
+        uint32_t a;
+        uint32_t b;
+        std::memcpy(&a, next + x, sizeof(a));
+        std::memcpy(&b, shown + x, sizeof(b));
+
+        const uint32_t diff = a ^ b;
+        if (diff == 0)
+        {
+            continue;
+        }
+
+        const int first = x + __builtin_ctz(diff) / 8;
+        const int last = x + 3 - __builtin_clz(diff) / 8;
+
+        if (runEnd >= 0 && first - runEnd <= SPAN_MERGE_GAP)
+        {
+            runEnd = last + 1;
+            continue;
+        }
+
+        if (runEnd >= 0)
+        {
+            AddSpan(page, runStart, runEnd);
+        }
+        runStart = first;
+        runEnd = last + 1;
+    }
+
+    if (runEnd >= 0)
+    {
+        AddSpan(page, runStart, runEnd);
+    }
+}
+
+void Display::StartNextTransfer()
+{
+    const uint8_t transfer = _nextTransfer;
+    if (transfer >= _spanCount * 2)
+    {
+        _flushing = false;
+        return;
+    }
+
+    _nextTransfer = transfer + 1;
+
+    const Span& span = _spans[transfer / 2];
+    const bool started = (transfer % 2 == 0)
+        ? _link->WriteAsync(SSD1306_CONTROL_COMMAND, span.window.data(), span.window.size())
+        : _link->WriteAsync(SSD1306_CONTROL_DATA, &Front()[span.page * DISPLAY_WIDTH + span.start],
+                            span.end - span.start);
+
+    if (!started)
+    {
+        _flushing = false;
+        _resendFrame = true;
+    }
+}
+
+void Display::OnTransferComplete(void* context, bool success)
+{
+    Display* display = static_cast<Display*>(context);
+    if (!success)
+    {
+        display->_flushing = false;
+        display->_resendFrame = true;
+        return;
+    }
+
+    if (display->_flushing)
+    {
+        display->StartNextTransfer();
+    }
+}
+
+bool Display::IsBusy() const
+{
+    // Query the link first: links without interrupts complete transfers
+    // (and advance the chain) while being polled.
+    const bool linkBusy = _link && _link->IsBusy();
+    return linkBusy || _flushing;
+}
+
+void Display::WaitForFlush() const
+{
+    while (IsBusy())
+    {
+    }
+}
+
+void Display::SendCommands(const uint8_t* commands, size_t size)
+{
+    _link->Write(SSD1306_CONTROL_COMMAND, commands, size);
+}
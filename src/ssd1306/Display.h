@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Blit.h"
+#include "I2CLink.h"
+#include "Sprite.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint8_t DISPLAY_WIDTH = 128;
+constexpr uint8_t DISPLAY_HEIGHT = 64;
+constexpr uint8_t DISPLAY_PAGES = DISPLAY_HEIGHT / 8;
+constexpr size_t DISPLAY_BUFFER_SIZE = DISPLAY_WIDTH * DISPLAY_PAGES;
+
+enum class FlushMode
+{
+    Blocking,
+    Async
+};
+
+class Display
+{
+public:
+    void Init(I2CLink* link);
+
+    void FillBlack();
+    void DrawPixel(uint8_t x, uint8_t y, bool color);
+    void DrawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool color);
+    void DrawCircle(uint8_t x, uint8_t y, uint8_t radius, bool color, bool fill = false);
+    void DrawImage(uint8_t x, uint8_t page, const uint8_t* image, size_t size, uint8_t pages);
+    void DrawImage(const std::array<uint8_t, DISPLAY_BUFFER_SIZE>& image);
+    // Decodes straight into the frame buffer; only the bytes that change
+    // are marked dirty.
+    void DrawImage(const CompressedImage& image);
+
+    // Draws at any y by whole bytes: a pre-shifted variant when the sprite
+    // has them, otherwise each byte is combined from two source pages.
+    void DrawSprite(int x, int y, const Sprite& sprite, BlitMode mode = BlitMode::Copy);
+
+    // Replaces a whole page with a composed line of DISPLAY_WIDTH bytes,
+    // marking only the bytes that differ as dirty.
+    void WritePage(uint8_t page, const uint8_t* line);
+
+    // Drawing always goes to the back buffer. UpdateScreen swaps it to the
+    // front and sends only the column spans touched since the last update;
+    // in Async mode it returns as soon as the first transfer is started.
+    void UpdateScreen();
+    void SwapBuffers();
+    bool IsBusy() const;
+    void WaitForFlush() const;
+
+    void SetFlushMode(FlushMode mode) { _flushMode = mode; }
+    FlushMode GetFlushMode() const { return _flushMode; }
+
+    // Compares dirty spans against the frame the panel currently shows and
+    // sends only the bytes that really changed. Redrawing identical content
+    // (e.g. a full-screen image every frame) then costs no I2C traffic.
+    void SetFrameDiff(bool enabled) { _frameDiff = enabled; }
+    bool GetFrameDiff() const { return _frameDiff; }
+
+private:
+    struct Span
+    {
+        uint8_t page;
+        uint8_t start;
+        uint8_t end;
+        std::array<uint8_t, 6> window;
+    };
+
+    using Buffer = std::array<uint8_t, DISPLAY_BUFFER_SIZE>;
+
+    void SendCommands(const uint8_t* commands, size_t size);
+    void SetPixel(int x, int y, bool color);
+    void MarkDirty(int page, int start, int end);
+    void MarkAllDirty();
+    void AddSpan(uint8_t page, uint8_t start, uint8_t end);
+    void AddChangedRuns(uint8_t page, uint8_t start, uint8_t end);
+
+    void StartNextTransfer();
+    static void OnTransferComplete(void* context, bool success);
+
+    Buffer& Back() { return _buffers[_back]; }
+    Buffer& Front() { return _buffers[_back ^ 1u]; }
+
+    I2CLink* _link = nullptr;
+    FlushMode _flushMode = FlushMode::Async;
+    bool _frameDiff = false;
+    alignas(uint32_t) std::array<Buffer, 2> _buffers{};
+    uint8_t _back = 0;
+
+    // Dirty column span [start, end) per page of the back buffer.
+    std::array<uint8_t, DISPLAY_PAGES> _dirtyStart{};
+    std::array<uint8_t, DISPLAY_PAGES> _dirtyEnd{};
+
+    // Spans of the front buffer being sent. Each span is two transfers:
+    // the address window, then the data.
+    static constexpr uint8_t MAX_SPANS_PER_PAGE = 4;
+    std::array<Span, DISPLAY_PAGES * MAX_SPANS_PER_PAGE> _spans{};
+    uint8_t _spanCount = 0;
+    volatile uint8_t _nextTransfer = 0;
+    volatile bool _flushing = false;
+    // Set when a transfer failed: the panel no longer matches the front
+    // buffer, so the next update resends the whole frame.
+    volatile bool _resendFrame = false;
+};
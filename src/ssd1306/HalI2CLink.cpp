@@ -0,0 +1,68 @@
+#include "HalI2CLink.h"
+
+namespace
+{
+    HalI2CLink* s_link = nullptr;
+    I2C_HandleTypeDef* s_hi2c = nullptr;
+}
+
+HalI2CLink::HalI2CLink(I2C_HandleTypeDef* hi2c, uint16_t address)
+{
+    _hi2c = hi2c;
+    _address = address;
+
+    s_link = this;
+    s_hi2c = hi2c;
+}
+
+bool HalI2CLink::Write(uint8_t control, const uint8_t* data, size_t size)
+{
+    while (_busy)
+    {
+    }
+
+    return HAL_I2C_Mem_Write(_hi2c, _address, control, I2C_MEMADD_SIZE_8BIT,
+                             const_cast<uint8_t*>(data), size, HAL_MAX_DELAY) == HAL_OK;
+}
+
+bool HalI2CLink::WriteAsync(uint8_t control, const uint8_t* data, size_t size)
+{
+    while (_busy)
+    {
+    }
+
+    _busy = true;
+    if (HAL_I2C_Mem_Write_DMA(_hi2c, _address, control, I2C_MEMADD_SIZE_8BIT,
+                              const_cast<uint8_t*>(data), size) != HAL_OK)
+    {
+        _busy = false;
+        return false;
+    }
+
+    return true;
+}
+
+extern "C" void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    if (s_link && hi2c == s_hi2c)
+    {
+        s_link->OnTransferComplete(true);
+    }
+}
+
+extern "C" void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c)
+{
+    if (s_link && hi2c == s_hi2c)
+    {
+        s_link->OnTransferComplete(false);
+    }
+}
+
+// Called by PendSV_Handler in stm32f4xx_it.c.
+extern "C" void HalI2CLink_PendSVHandler()
+{
+    if (s_link)
+    {
+        s_link->OnPendSV();
+    }
+}
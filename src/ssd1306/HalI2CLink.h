@@ -0,0 +1,41 @@
+#pragma once
+
+extern "C"
+{
+#include "stm32f4xx_hal.h"
+}
+
+#include "I2CLink.h"
+
+constexpr uint16_t SSD1306_I2C_ADDRESS = 0x3C << 1;
+
+class HalI2CLink : public I2CLink
+{
+public:
+    explicit HalI2CLink(I2C_HandleTypeDef* hi2c, uint16_t address = SSD1306_I2C_ADDRESS);
+
+    bool Write(uint8_t control, const uint8_t* data, size_t size) override;
+    bool WriteAsync(uint8_t control, const uint8_t* data, size_t size) override;
+    bool IsBusy() const override { return _busy; }
+
+    // Called from the I2C and DMA interrupts. The completion handler is
+    // deferred to PendSV: starting the next transfer busy-waits through the
+    // address phase, and only below SysTick can its HAL timeouts expire.
+    void OnTransferComplete(bool success)
+    {
+        _success = success;
+        SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    }
+
+    void OnPendSV()
+    {
+        _busy = false;
+        NotifyComplete(_success);
+    }
+
+private:
+    I2C_HandleTypeDef* _hi2c;
+    uint16_t _address;
+    volatile bool _busy = false;
+    volatile bool _success = true;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint8_t SSD1306_CONTROL_COMMAND = 0x00;
+constexpr uint8_t SSD1306_CONTROL_DATA = 0x40;
+
+// Transport used by Display to talk to the panel. Every transaction is a
+// control byte (command or data stream) followed by the payload.
+class I2CLink
+{
+public:
+    using CompletionHandler = void (*)(void* context, bool success);
+
+    virtual ~I2CLink() = default;
+
+    virtual bool Write(uint8_t control, const uint8_t* data, size_t size) = 0;
+
+    // Starts the transfer and returns immediately. The payload must stay
+    // untouched until IsBusy() returns false.
+    virtual bool WriteAsync(uint8_t control, const uint8_t* data, size_t size) = 0;
+    virtual bool IsBusy() const = 0;
+
+    // Called once an asynchronous transfer has finished, possibly from an
+    // interrupt; success is false when the bus reported an error and the
+    // payload may not have reached the panel. The handler may start the
+    // next transfer.
+    void SetCompletionHandler(CompletionHandler handler, void* context)
+    {
+        _completionHandler = handler;
+        _completionContext = context;
+    }
+
+protected:
+    void NotifyComplete(bool success)
+    {
+        if (_completionHandler)
+        {
+            _completionHandler(_completionContext, success);
+        }
+    }
+
+private:
+    CompletionHandler _completionHandler = nullptr;
+    void* _completionContext = nullptr;
+};
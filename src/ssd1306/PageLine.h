@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Blit.h"
+#include "Display.h"
+
+#include <array>
+#include <cstdint>
+
+// Scratch copy of one page, starting out black, that a frame's objects are
+// composed into before it replaces the page in the frame buffer.
+class PageLine
+{
+public:
+    explicit PageLine(uint8_t page) : _page(page) {}
+
+    uint8_t GetPage() const { return _page; }
+    const uint8_t* Data() const { return _bytes.data(); }
+
+    bool IntersectsRows(int y, int height) const
+    {
+        return y < (_page + 1) * 8 && y + height > _page * 8;
+    }
+
+    void DrawRect(int x, int y, int w, int h, bool color)
+    {
+        Blit::FillRect(_bytes.data(), _page, x, y, w, h, color);
+    }
+
+    void DrawSprite(int x, int y, const Sprite& sprite, BlitMode mode = BlitMode::Copy)
+    {
+        Blit::DrawSprite(_bytes.data(), _page, x, y, sprite, mode);
+    }
+
+    void DrawPixel(int x, int y, bool color)
+    {
+        if (x < 0 || x >= DISPLAY_WIDTH || y < _page * 8 || y >= (_page + 1) * 8)
+        {
+            return;
+        }
+
+        const uint8_t mask = 1u << (y % 8);
+        _bytes[x] = color ? (_bytes[x] | mask) : (_bytes[x] & ~mask);
+    }
+
+private:
+    uint8_t _page;
+    std::array<uint8_t, DISPLAY_WIDTH> _bytes{};
+};
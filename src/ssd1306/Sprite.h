@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Bitmap in the panel's page layout, as packed into the sprite atlas by
+// utils/make_atlas.py.
+struct Sprite
+{
+    const uint8_t* data;     // pages * width bytes
+    const uint8_t* shifted;  // variants moved up by 1..7 pixels, or nullptr
+    uint8_t width;
+    uint8_t height;
+    uint8_t pages;
+
+    constexpr size_t Size() const { return width * pages; }
+
+    // Variant moved up by shift (1..7) pixels; it spans pages + 1 pages.
+    constexpr const uint8_t* Shifted(uint8_t shift) const
+    {
+        return shifted + (shift - 1) * (pages + 1) * width;
+    }
+};
+
+// Full-screen frame buffer image in which every run of zero bytes is stored
+// as 0x00 followed by the run length.
+struct CompressedImage
+{
+    const uint8_t* data;
+    uint16_t size;
+};
@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+"""
+SSD1306 Sprite Atlas Generator
+Packs BMP images into one constexpr C++ header for the SSD1306 page layout
+(one byte = 8 vertical pixels, bit 0 at the bottom, page 0 at the bottom).
+Images whose height is not a multiple of 8 are padded at the top.
+
+Every sprite gets its width, height and page count, a pointer to its bitmap
+and seven pre-shifted variants for drawing at a y that is not a multiple of
+8. Variant s is the bitmap moved up by s pixels and is one page taller.
+
+Full-screen images are stored as a CompressedImage instead: the frame
+buffer bytes with every run of zeros written as 0x00 followed by the run
+length (1-255).
+
+Usage: make_atlas.py -o Sprites.h image.bmp [image.bmp ...]
+The sprite name is the file name in PascalCase (game_over.bmp -> GameOver).
+"""
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+
+THRESHOLD = 128         # Brightness threshold 0-255 (pixels >= threshold are lit)
+BYTES_PER_LINE = 16     # Number of bytes per line in the output array
+SCREEN_WIDTH = 128
+SCREEN_HEIGHT = 64
+
+
+def read_bmp(path):
+    """Read an uncompressed 1/4/8/24/32-bit BMP into rows of booleans, bottom row first."""
+    data = Path(path).read_bytes()
+    if data[:2] != b"BM":
+        raise ValueError("not a BMP file")
+
+    pixel_offset = struct.unpack_from("<I", data, 10)[0]
+    header_size, width, height, _, bpp, compression = struct.unpack_from("<IiiHHI", data, 14)
+    if compression not in (0, 3):
+        raise ValueError("compressed BMPs are not supported")
+
+    palette = []
+    if bpp <= 8:
+        colors = struct.unpack_from("<I", data, 46)[0] or (1 << bpp)
+        for i in range(colors):
+            b, g, r, _ = data[14 + header_size + i * 4:18 + header_size + i * 4]
+            palette.append((r, g, b))
+
+    bottom_up = height > 0
+    height = abs(height)
+    stride = (width * bpp + 31) // 32 * 4
+
+    rows = []
+    for row in range(height):
+        file_row = row if bottom_up else height - 1 - row
+        start = pixel_offset + file_row * stride
+        pixels = []
+        for x in range(width):
+            if bpp >= 24:
+                b, g, r = data[start + x * (bpp // 8):start + x * (bpp // 8) + 3]
+            else:
+                bit = x * bpp
+                index = (data[start + bit // 8] >> (8 - bpp - bit % 8)) & ((1 << bpp) - 1)
+                r, g, b = palette[index]
+            pixels.append((r * 299 + g * 587 + b * 114) // 1000 >= THRESHOLD)
+        rows.append(pixels)
+
+    return width, height, rows
+
+
+def to_pages(width, height, rows):
+    pages = []
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            byte_value = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and rows[y][x]:
+                    byte_value |= 1 << bit
+            pages.append(byte_value)
+    return pages
+
+
+def shift_pages(pages, width, page_count, shift):
+    shifted = []
+    for page in range(page_count + 1):
+        for x in range(width):
+            low = pages[(page - 1) * width + x] if page > 0 else 0
+            high = pages[page * width + x] if page < page_count else 0
+            shifted.append(((high << shift) | (low >> (8 - shift))) & 0xFF)
+    return shifted
+
+
+def zero_run_encode(data):
+    encoded = []
+    i = 0
+    while i < len(data):
+        if data[i] != 0:
+            encoded.append(data[i])
+            i += 1
+            continue
+
+        run = 1
+        while i + run < len(data) and data[i + run] == 0 and run < 255:
+            run += 1
+        encoded += [0, run]
+        i += run
+    return encoded
+
+
+def sprite_name(path):
+    return "".join(part.capitalize() for part in Path(path).stem.replace("-", "_").split("_"))
+
+
+def format_bytes(data):
+    lines = []
+    for i in range(0, len(data), BYTES_PER_LINE):
+        chunk = data[i:i + BYTES_PER_LINE]
+        line = "    " + ", ".join(f"0x{byte:02X}" for byte in chunk)
+        if i + BYTES_PER_LINE < len(data):
+            line += ","
+        lines.append(line)
+    return lines
+
+
+def generate_header(images):
+    atlas = []
+    compressed = []
+    sprites = []
+    images_out = []
+
+    for path in images:
+        width, height, rows = read_bmp(path)
+        page_count = (height + 7) // 8
+        pages = to_pages(width, height, rows)
+
+        if (width, height) == (SCREEN_WIDTH, SCREEN_HEIGHT):
+            encoded = zero_run_encode(pages)
+            images_out.append((sprite_name(path), Path(path).name, len(compressed), len(encoded)))
+            compressed += encoded
+            continue
+
+        offset = len(atlas)
+        atlas += pages
+
+        shifted = len(atlas)
+        for shift in range(1, 8):
+            atlas += shift_pages(pages, width, page_count, shift)
+
+        sprites.append((sprite_name(path), Path(path).name, width, height, page_count, offset, shifted))
+
+    lines = [
+        "#pragma once",
+        "",
+        "// Generated by utils/make_atlas.py, do not edit.",
+        "",
+        '#include "ssd1306/Sprite.h"',
+        "",
+        "#include <array>",
+        "#include <cstdint>",
+        "",
+        "namespace Sprites",
+        "{",
+        f"inline constexpr std::array<uint8_t, {len(atlas)}> Atlas = {{",
+    ]
+    lines += format_bytes(atlas)
+    lines.append("};")
+    lines.append("")
+    lines.append(f"inline constexpr std::array<uint8_t, {len(compressed)}> Compressed = {{")
+    lines += format_bytes(compressed)
+    lines.append("};")
+    lines.append("")
+
+    for name, source, width, height, page_count, offset, shifted in sprites:
+        lines.append(f"// {source}: {width}x{height}")
+        lines.append(f"inline constexpr Sprite {name} = {{&Atlas[{offset}], &Atlas[{shifted}], {width}, {height}, {page_count}}};")
+
+    for name, source, offset, size in images_out:
+        lines.append(f"// {source}: full screen, {size} bytes compressed")
+        lines.append(f"inline constexpr CompressedImage {name} = {{&Compressed[{offset}], {size}}};")
+
+    lines.append("}")
+    lines.append("")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-o", "--output", required=True, help="header to write")
+    parser.add_argument("images", nargs="+", help="BMP files to pack")
+    args = parser.parse_args()
+
+    try:
+        header = generate_header(sorted(args.images))
+    except (OSError, ValueError, struct.error) as e:
+        print(f"Error: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    output = Path(args.output)
+    output.parent.mkdir(parents=True, exist_ok=True)
+    if not output.exists() or output.read_text() != header:
+        output.write_text(header)
+
+
+if __name__ == "__main__":
+    main()